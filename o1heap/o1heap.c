@@ -30,6 +30,189 @@
 #    include O1HEAP_CONFIG_HEADER
 #endif
 
+/// Define this macro as 0 to compile out the maintenance of the runtime diagnostic counters (allocated,
+/// peak_allocated, peak_request_size, oom_count) from the (de-)allocation hot paths. This saves over a dozen
+/// cycles per call, which may be significant for the most performance-sensitive applications.
+/// When disabled, o1heapGetDiagnostics() remains available but only the capacity field is valid;
+/// the other fields are permanently zero.
+#ifndef O1HEAP_DIAGNOSTICS
+#    define O1HEAP_DIAGNOSTICS 1
+#endif
+
+/// Define this macro as a positive number L to cap the supported heap capacity at 2**L bytes in exchange for a
+/// compact instance: the per-instance bin tables shrink from one entry per size_t bit down to only the size
+/// classes reachable under the cap, so a small-footprint instance fits in one or two cache lines (faster accesses
+/// adjacent to nonempty_bin_mask on every allocation/free, and a smaller per-instance cost when running many
+/// instances per chip). o1heapInit() clips larger arenas to the cap, same as the platform limit in the default
+/// configuration. The value shall be less than the bit width of size_t and no less than log2 of the minimum
+/// fragment size (4x the pointer width); zero (the default) engages the platform maximum of approx. SIZE_MAX/2.
+/// This option affects the memory layout of the public O1HeapTelemetry type, so it must be defined consistently
+/// for the library and its users (e.g., project-wide via the build system).
+#ifndef O1HEAP_MAX_CAPACITY_LOG2
+#    define O1HEAP_MAX_CAPACITY_LOG2 0
+#endif
+
+/// Define this macro as a positive number B to subdivide every power-of-2 size class into 2**B linear sub-bins,
+/// TLSF style. With sub-bins the allocation size is rounded up to the fragment granularity instead of the next
+/// power of 2, which cuts the worst-case rounding waste from ~50% of each fragment to one sub-bin step, at the
+/// cost of a larger instance footprint (the bin array and the second-level bitmaps grow by the factor of 2**B).
+/// The lookup remains constant-time: two bitmask scans instead of one. Sensible values are 2..4; 0 (the default)
+/// selects the classic single-level power-of-2 binning with the original instance layout.
+#ifndef O1HEAP_SUBBIN_BITS
+#    define O1HEAP_SUBBIN_BITS 0
+#endif
+
+/// Define this macro as a positive number N to enable the magazine cache for the N smallest size classes
+/// (i.e., fragments of up to FRAGMENT_SIZE_MIN*2**(N-1) bytes). A magazine is a small per-class LIFO stack of
+/// freed fragments that are kept allocated-shaped: freeing into a magazine skips the coalescing logic and
+/// allocating from one skips the bin search and split, so the common small-object path reduces to a pointer pop.
+/// A full magazine is flushed back into the bins in one bounded batch, preserving the constant WCET.
+/// Memory parked in magazines is reported as allocated by the diagnostics. Disabled (0) by default.
+#ifndef O1HEAP_MAGAZINE_BINS
+#    define O1HEAP_MAGAZINE_BINS 0
+#endif
+
+/// The maximum number of fragments cached per magazine before it is flushed back into the bins.
+/// Only relevant if O1HEAP_MAGAZINE_BINS is positive.
+#ifndef O1HEAP_MAGAZINE_DEPTH
+#    define O1HEAP_MAGAZINE_DEPTH 8U
+#endif
+
+#if (O1HEAP_SUBBIN_BITS > 0) && (O1HEAP_MAGAZINE_BINS > 0)
+#    error "O1HEAP_SUBBIN_BITS is incompatible with O1HEAP_MAGAZINE_BINS: magazines are keyed by power-of-2 class."
+#endif
+
+/// Define this macro as a positive number N to enable cache coloring: when serving an allocation, up to N leading
+/// entries of the selected bin list are examined and the first one mapping to a different cache set than the
+/// previously served fragment is preferred. Because fragments of one size class are spaced by powers of 2, the
+/// plain LIFO policy tends to hand out addresses congruent modulo the L1 size, so hot same-class objects evict
+/// each other through set conflicts; the colored selection spreads them across sets instead. The scan is bounded
+/// by this compile-time constant, so the lookup remains constant-time. Sensible values are 2..8; 0 (the default)
+/// disables the feature and restores the pure most-recently-used selection.
+#ifndef O1HEAP_COLOR_LOOKAHEAD
+#    define O1HEAP_COLOR_LOOKAHEAD 0
+#endif
+
+/// The L1 data cache geometry used by the coloring policy: the color of a fragment is its address shifted right
+/// by O1HEAP_COLOR_SHIFT (log2 of the cache line size) modulo O1HEAP_COLOR_COUNT (the number of sets).
+/// The defaults describe a common 32K 8-way cache with 64-byte lines; adjust to the target if known.
+/// Only relevant if O1HEAP_COLOR_LOOKAHEAD is positive.
+#ifndef O1HEAP_COLOR_SHIFT
+#    define O1HEAP_COLOR_SHIFT 6U
+#endif
+#ifndef O1HEAP_COLOR_COUNT
+#    define O1HEAP_COLOR_COUNT 64U
+#endif
+
+/// Define this macro as 1 to enable the incremental scrub engine: o1heapAllocateZeroed() and o1heapScrubStep().
+/// Zero-filling is a variable-complexity operation, which is why o1heapAllocate() never does it; with this option
+/// the zeroing cost can be moved into an idle task, which pre-zeroes fragments in bounded increments so that
+/// o1heapAllocateZeroed() can serve from the pre-scrubbed pool in constant time. Disabled by default.
+#ifndef O1HEAP_ENABLE_SCRUB
+#    define O1HEAP_ENABLE_SCRUB 0
+#endif
+
+/// Define this macro as 1 to enable the free-space telemetry: o1heapGetTelemetry(). The telemetry counters
+/// (per-bin free fragment counts, cumulative split/merge counters) describe the free side of the heap, allowing
+/// the application to observe external fragmentation and alarm before an allocation fails with OOM.
+/// The maintenance cost is one array increment/decrement per bin operation. Disabled by default.
+#ifndef O1HEAP_TELEMETRY
+#    define O1HEAP_TELEMETRY 0
+#endif
+
+/// O1HEAP_TRACE_HOOK(handle, event, pointer, size) is invoked by o1heapAllocate(), o1heapFree(),
+/// o1heapReallocate(), and the batch API (one event per element, so recorded traces remain replayable)
+/// with one of the O1HEAP_TRACE_EVENT_* identifiers declared in the header, enabling
+/// allocation-site profiling and offline trace replay. By default the macro expands to nothing, so the hot paths
+/// carry zero overhead; a recording definition can be supplied via O1HEAP_CONFIG_HEADER or the -D compiler flag.
+/// A reference lock-free ring-buffer recorder is provided in the companion module o1heap_trace.c/o1heap_trace.h.
+/// Note that a reallocation that has to move the data emits nested allocate/free events after its own event.
+#ifndef O1HEAP_TRACE_HOOK
+// Intentional violation of MISRA: a function-like macro is required because the default must compile out entirely.
+#    define O1HEAP_TRACE_HOOK(handle, event, pointer, size)  // NOSONAR
+#endif
+
+/// Define this macro as 1 to enable the checkpoint/rollback API: o1heapMark() and o1heapRelease().
+/// Fragments allocated while a mark is active are tagged with a spare bit of the packed fragment header, so a
+/// mark costs nothing on the hot paths; a release frees all tagged fragments in one linear pass over the arena.
+/// Disabled by default.
+#ifndef O1HEAP_ENABLE_MARK_RELEASE
+#    define O1HEAP_ENABLE_MARK_RELEASE 0
+#endif
+
+/// Define this macro as 1 to enable the hardened mode: o1heapFree() validates the structural integrity of the
+/// fragment in constant time before touching any state, and rejects double-frees and wild pointers by bumping the
+/// bad_free_count diagnostic instead of corrupting the bins. This is much cheaper than the full assertion checks
+/// and is intended to be left enabled in production builds where O1HEAP_ASSERT is compiled out. Disabled by default.
+#ifndef O1HEAP_ENABLE_HARDENING
+#    define O1HEAP_ENABLE_HARDENING 0
+#endif
+
+/// Define this macro as 1 to enable the incremental defragmentation engine: o1heapMakeRelocatable() and
+/// o1heapDefragStep(). Objects registered as relocatable may be slid towards lower addresses by the defrag steps,
+/// healing the interleaved used/free patterns that the bin policy alone never compacts on long-running devices.
+/// The registration table adds a fixed footprint to the instance (see O1HEAP_DEFRAG_SLOTS). Disabled by default.
+#ifndef O1HEAP_ENABLE_DEFRAG
+#    define O1HEAP_ENABLE_DEFRAG 0
+#endif
+
+/// The capacity of the relocatable-object registration table; only relevant if O1HEAP_ENABLE_DEFRAG is enabled.
+/// It bounds both the instance footprint and the worst-case execution time of one defragmentation step.
+#ifndef O1HEAP_DEFRAG_SLOTS
+#    define O1HEAP_DEFRAG_SLOTS 16U
+#endif
+
+/// Define this macro as 1 to enable the guaranteed-reserve pool: o1heapReserve() and o1heapAllocateReserved().
+/// The reserve is a private list of pre-carved fragments that are kept allocated-shaped, so the main workload can
+/// never consume them; an OOM-critical path (e.g., fault logging) pops one in constant time regardless of the
+/// bin state. Freed reserve fragments return to the reserve rather than to the general bins, preserving the
+/// worst-case availability guarantee for the lifetime of the instance. Disabled by default.
+#ifndef O1HEAP_ENABLE_RESERVE
+#    define O1HEAP_ENABLE_RESERVE 0
+#endif
+
+/// Define this macro as 1 to enable cross-instance fragment migration: o1heapDonate().
+/// It moves a large free fragment from one live instance to another in constant time, which allows coexisting
+/// heaps (e.g., separate RX/TX pools in one SRAM bank) to track a shifting load split without over-provisioning
+/// both for their respective peaks. The receiving instance keeps a small table of adopted region bounds;
+/// its size is set by O1HEAP_DONATE_REGIONS. Disabled by default.
+#ifndef O1HEAP_ENABLE_DONATE
+#    define O1HEAP_ENABLE_DONATE 0
+#endif
+
+/// The capacity of the adopted-region table; only relevant if O1HEAP_ENABLE_DONATE is enabled.
+/// It bounds both the instance footprint and the worst-case execution time of the region lookup performed when
+/// the size of a chain-terminating fragment is computed.
+#ifndef O1HEAP_DONATE_REGIONS
+#    define O1HEAP_DONATE_REGIONS 4U
+#endif
+
+/// Define this macro as 1 to enable the deferred free API: o1heapFreeDeferred() and o1heapDrainDeferred().
+/// It allows threads that do not own the heap to return memory via a lock-free intrusive MPSC stack instead of
+/// wrapping o1heapFree() in a critical section. The feature requires atomic pointer operations (see below)
+/// and adds one pointer to the instance footprint, hence it is disabled by default.
+#ifndef O1HEAP_ENABLE_DEFERRED_FREE
+#    define O1HEAP_ENABLE_DEFERRED_FREE 0
+#endif
+
+/// The atomic pointer operations are only required if O1HEAP_ENABLE_DEFERRED_FREE is enabled.
+/// The defaults provided for GCC/Clang are sequentially consistent acquire/release operations on pointer objects;
+/// other compilers require the user to provide equivalents via O1HEAP_CONFIG_HEADER.
+/// O1HEAP_ATOMIC_CAS_PTR shall atomically compare *ptr with *expected and store desired on match, returning true;
+/// on mismatch it shall update *expected with the current value and return false (i.e., the C11 CAS semantics).
+#if O1HEAP_ENABLE_DEFERRED_FREE
+#    if !defined(O1HEAP_ATOMIC_EXCHANGE_PTR) && (defined(__GNUC__) || defined(__clang__) || defined(__CC_ARM))
+#        define O1HEAP_ATOMIC_EXCHANGE_PTR(ptr, desired) __atomic_exchange_n((ptr), (desired), __ATOMIC_ACQ_REL)
+#    endif
+#    if !defined(O1HEAP_ATOMIC_CAS_PTR) && (defined(__GNUC__) || defined(__clang__) || defined(__CC_ARM))
+#        define O1HEAP_ATOMIC_CAS_PTR(ptr, expected, desired) \
+            __atomic_compare_exchange_n((ptr), (expected), (desired), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#    endif
+#    if !defined(O1HEAP_ATOMIC_EXCHANGE_PTR) || !defined(O1HEAP_ATOMIC_CAS_PTR)
+#        error "O1HEAP_ENABLE_DEFERRED_FREE requires atomic pointer operations; see O1HEAP_CONFIG_HEADER."
+#    endif
+#endif
+
 /// The assertion macro defaults to the standard assert().
 /// It can be overridden to manually suppress assertion checks or use a different error handling policy.
 #ifndef O1HEAP_ASSERT
@@ -105,14 +288,43 @@ O1HEAP_PRIVATE uint_fast8_t O1HEAP_CLZ(const size_t x)
 /// then follows the user data which shall keep the next fragment aligned.
 #define FRAGMENT_SIZE_MIN (O1HEAP_ALIGNMENT * 2U)
 
+/// Log2 of FRAGMENT_SIZE_MIN as a constant expression (the preprocessor cannot compute log2 of a sizeof).
+#define FRAGMENT_SIZE_MIN_LOG2 \
+    ((sizeof(void*) == 2U) ? 3U : ((sizeof(void*) == 4U) ? 4U : ((sizeof(void*) == 8U) ? 5U : 6U)))
+
 /// This is risky, handle with care: if the allocation amount plus per-fragment overhead exceeds 2**(b-1),
 /// where b is the pointer bit width, then ceil(log2(amount)) yields b; then 2**b causes an integer overflow.
-/// To avoid this, we put a hard limit on fragment size (which is amount + per-fragment overhead): 2**(b-1)
-#define FRAGMENT_SIZE_MAX ((SIZE_MAX >> 1U) + 1U)
+/// To avoid this, we put a hard limit on fragment size (which is amount + per-fragment overhead): 2**(b-1).
+/// If the capacity is capped via O1HEAP_MAX_CAPACITY_LOG2, the cap is the limit; o1heapInit() clips the arena.
+#if O1HEAP_MAX_CAPACITY_LOG2 > 0
+#    define FRAGMENT_SIZE_MAX (((size_t) 1U) << O1HEAP_MAX_CAPACITY_LOG2)
+#else
+#    define FRAGMENT_SIZE_MAX ((SIZE_MAX >> 1U) + 1U)
+#endif
+
+/// With the capacity capped, only the reachable size classes get a bin, which makes the instance much smaller
+/// (a few cache lines instead of many); otherwise one bin per size_t bit is provisioned, which certainly leaves
+/// some of the topmost bins unused, but that is cheap to ignore on platforms with memory to spare.
+#if O1HEAP_MAX_CAPACITY_LOG2 > 0
+#    define NUM_BINS_MAX ((((size_t) O1HEAP_MAX_CAPACITY_LOG2) - FRAGMENT_SIZE_MIN_LOG2) + 1U)
+#else
+#    define NUM_BINS_MAX (sizeof(size_t) * CHAR_BIT)
+#endif
 
-/// Normally we should subtract log2(FRAGMENT_SIZE_MIN) but log2 is bulky to compute using the preprocessor only.
-/// We will certainly end up with unused bins this way, but it is cheap to ignore.
-#define NUM_BINS_MAX (sizeof(size_t) * CHAR_BIT)
+static_assert((((size_t) 1U) << FRAGMENT_SIZE_MIN_LOG2) == FRAGMENT_SIZE_MIN, "Invalid FRAGMENT_SIZE_MIN_LOG2");
+static_assert(NUM_BINS_MAX == O1HEAP_BIN_COUNT, "The public bin count shall mirror the private definition");
+static_assert(FRAGMENT_SIZE_MAX >= FRAGMENT_SIZE_MIN, "O1HEAP_MAX_CAPACITY_LOG2 is too small for this platform");
+
+/// The number of sub-bins per power-of-2 size class and the total number of fragment lists.
+/// With O1HEAP_SUBBIN_BITS=0 there is exactly one list per class and the classic layout is preserved.
+#define SUBBIN_COUNT (((size_t) 1U) << O1HEAP_SUBBIN_BITS)
+#define NUM_LISTS_TOTAL (NUM_BINS_MAX << O1HEAP_SUBBIN_BITS)
+
+static_assert(O1HEAP_SUBBIN_BITS <= 4, "Too many sub-bins: the second-level bitmap must fit into size_t easily");
+
+#if O1HEAP_COLOR_LOOKAHEAD > 0
+static_assert((O1HEAP_COLOR_COUNT & (O1HEAP_COLOR_COUNT - 1U)) == 0U, "Not a power of 2");
+#endif
 
 static_assert((O1HEAP_ALIGNMENT & (O1HEAP_ALIGNMENT - 1U)) == 0U, "Not a power of 2");
 static_assert((FRAGMENT_SIZE_MIN & (FRAGMENT_SIZE_MIN - 1U)) == 0U, "Not a power of 2");
@@ -120,11 +332,34 @@ static_assert((FRAGMENT_SIZE_MAX & (FRAGMENT_SIZE_MAX - 1U)) == 0U, "Not a power
 
 typedef struct Fragment Fragment;
 
+/// The prev pointer is packed with the flag bits; the fragment alignment guarantees they are otherwise unused.
+/// Bit 0 is the 'used' flag; bit 1 is the 'speculative' flag, only maintained if O1HEAP_ENABLE_MARK_RELEASE;
+/// bit 2 is the 'reserved' flag, only maintained if O1HEAP_ENABLE_RESERVE;
+/// bit 3 is the 'donated' flag, only maintained if O1HEAP_ENABLE_DONATE.
+#if O1HEAP_ENABLE_MARK_RELEASE
+#    define FRAGMENT_FLAG_SPECULATIVE ((uintptr_t) 2U)
+#else
+#    define FRAGMENT_FLAG_SPECULATIVE ((uintptr_t) 0U)
+#endif
+#if O1HEAP_ENABLE_RESERVE
+#    define FRAGMENT_FLAG_RESERVED ((uintptr_t) 4U)
+#else
+#    define FRAGMENT_FLAG_RESERVED ((uintptr_t) 0U)
+#endif
+#if O1HEAP_ENABLE_DONATE
+#    define FRAGMENT_FLAG_DONATED ((uintptr_t) 8U)
+#else
+#    define FRAGMENT_FLAG_DONATED ((uintptr_t) 0U)
+#endif
+#define FRAGMENT_FLAGS_MASK \
+    (((uintptr_t) 1U) | FRAGMENT_FLAG_SPECULATIVE | FRAGMENT_FLAG_RESERVED | FRAGMENT_FLAG_DONATED)
+static_assert(FRAGMENT_FLAGS_MASK < O1HEAP_ALIGNMENT, "The flag bits must fit in the alignment slack of the pointer");
+
 /// Size is computed dynamically from (next - this) or (arena_end - this) for the last fragment.
 typedef struct FragmentHeader
 {
     Fragment* next;       ///< Next fragment in address order; NULL if this is the last fragment.
-    uintptr_t prev_used;  ///< Prev pointer in upper bits, 'used' flag in bit 0.
+    uintptr_t prev_used;  ///< Prev pointer in upper bits, flag bits at the bottom (see FRAGMENT_FLAGS_MASK).
 } FragmentHeader;
 static_assert(sizeof(FragmentHeader) == sizeof(void*) * 2U, "Memory layout error");
 static_assert(sizeof(FragmentHeader) == O1HEAP_ALIGNMENT, "Memory layout error");
@@ -140,14 +375,100 @@ static_assert(sizeof(Fragment) <= FRAGMENT_SIZE_MIN, "Memory layout error");
 
 struct O1HeapInstance
 {
-    Fragment* bins[NUM_BINS_MAX];  ///< Smallest fragments are in the bin at index 0.
-    size_t    nonempty_bin_mask;   ///< Bit 1 represents a non-empty bin; bin at index 0 is for the smallest fragments.
+    Fragment* bins[NUM_LISTS_TOTAL];  ///< Smallest fragments are in the bin at index 0.
+    size_t    nonempty_bin_mask;  ///< Bit 1 represents a non-empty bin; bin at index 0 is for the smallest fragments.
+
+#if O1HEAP_SUBBIN_BITS > 0
+    /// Second-level bitmaps: bit s of subbin_masks[i] is set iff the sub-bin s of the class i is non-empty.
+    /// The nonempty_bin_mask above works at the class level: bit i is set iff subbin_masks[i] is non-zero.
+    size_t subbin_masks[NUM_BINS_MAX];
+#endif
 
     char* arena_end;  ///< Points past the last byte of the arena; used for computing size of the last fragment.
 
+    /// Non-NULL iff a part of the arena is not yet committed (see o1heapInitLazy()); points to the used-marked
+    /// fragment covering the uncommitted tail. The fragment is owned by the allocator and is never allocatable;
+    /// o1heapExtend() carves committed space off its front. NULL for instances created via o1heapInit().
+    Fragment* uncommitted;
+
+    /// The resumption point of a chunked o1heapIterate() walk; NULL when no walk is in progress.
+    Fragment* iterate_cursor;
+
+    /// The resumption point of a chunked o1heapValidateFull() scan; NULL when no scan is in progress.
+    Fragment* validate_cursor;
+
     O1HeapDiagnostics diagnostics;
+
+#if O1HEAP_ENABLE_DEFERRED_FREE
+    /// Head of the lock-free intrusive MPSC stack of fragments freed from non-owning threads.
+    /// Accessed only via the atomic pointer operations; the fragments are linked through their next_free fields.
+    Fragment* deferred_free_head;
+#endif
+
+#if O1HEAP_MAGAZINE_BINS > 0
+    /// Per-class LIFO stacks of freed fragments kept allocated-shaped (marked used, linked via next_free).
+    Fragment* magazine_heads[O1HEAP_MAGAZINE_BINS];
+    size_t    magazine_sizes[O1HEAP_MAGAZINE_BINS];
+#endif
+
+#if O1HEAP_COLOR_LOOKAHEAD > 0
+    /// The cache color (set index) of the most recently served fragment; see binFind().
+    size_t last_color;
+#endif
+
+#if O1HEAP_ENABLE_RESERVE
+    /// The private LIFO list of pre-carved reserve fragments kept allocated-shaped (marked used & reserved,
+    /// linked via next_free), and the number of fragments currently parked there. See o1heapReserve().
+    Fragment* reserve_head;
+    size_t    reserve_count;
+#endif
+
+#if O1HEAP_ENABLE_DONATE
+    /// Bounds of the arena regions adopted from other instances via o1heapDonate(). Each adopted region hosts an
+    /// independent fragment chain whose terminating fragment derives its size from the matching end pointer, the
+    /// same way the primary chain derives it from arena_end. Unused slots hold NULL pointers.
+    char*  region_starts[O1HEAP_DONATE_REGIONS];
+    char*  region_ends[O1HEAP_DONATE_REGIONS];
+    size_t region_count;
+#endif
+
+#if O1HEAP_TELEMETRY
+    /// Free-space telemetry counters; see o1heapGetTelemetry(). The bin counts are maintained next to the bin
+    /// lists themselves; the split/merge counters are incremented at the sites where the fragment chain changes.
+    size_t   bin_fragment_counts[NUM_BINS_MAX];
+    uint64_t split_count;
+    uint64_t merge_count;
+#endif
+
+#if O1HEAP_ENABLE_MARK_RELEASE
+    /// When true, newly allocated fragments are tagged speculative so that o1heapRelease() can find them.
+    bool mark_active;
+#endif
+
+#if O1HEAP_ENABLE_DEFRAG
+    /// The relocatable-object registration table; see o1heapMakeRelocatable(). Empty slots hold NULL pointers.
+    /// The table stores user pointers rather than fragment pointers so that the free/realloc bookkeeping can
+    /// match its argument directly.
+    void*                    reloc_pointers[O1HEAP_DEFRAG_SLOTS];
+    O1HeapRelocationCallback reloc_callbacks[O1HEAP_DEFRAG_SLOTS];
+#endif
+
+#if O1HEAP_ENABLE_SCRUB
+    /// Per-class LIFO pools of pre-zeroed fragments kept allocated-shaped (marked used, linked via next_free).
+    Fragment* zeroed_bins[NUM_BINS_MAX];
+    /// Size classes for which o1heapAllocateZeroed() recently missed; the scrubber replenishes these on demand.
+    size_t zeroed_demand_mask;
+    /// The fragment currently being zeroed incrementally, if any, and the number of payload bytes done so far.
+    Fragment* scrub_frag;
+    size_t    scrub_done;
+#endif
 };
 
+#if O1HEAP_MAGAZINE_BINS > 0
+static_assert(O1HEAP_MAGAZINE_BINS <= NUM_BINS_MAX, "Invalid magazine configuration");
+static_assert(O1HEAP_MAGAZINE_DEPTH >= 1U, "Invalid magazine configuration");
+#endif
+
 /// The amount of space allocated for the heap instance.
 /// Its size is padded up to O1HEAP_ALIGNMENT to ensure correct alignment of the allocation arena that follows.
 #define INSTANCE_SIZE_PADDED ((sizeof(O1HeapInstance) + O1HEAP_ALIGNMENT - 1U) & ~(O1HEAP_ALIGNMENT - 1U))
@@ -184,6 +505,31 @@ O1HEAP_PRIVATE size_t roundUpToPowerOf2(const size_t x)
     return ((size_t) 1U) << ((sizeof(x) * CHAR_BIT) - ((uint_fast8_t) O1HEAP_CLZ(x - 1U)));
 }
 
+/// Computes the fragment size required to serve an allocation of the specified amount.
+/// With sub-bins enabled the size is only rounded up to the fragment granularity, which is the whole point of
+/// the two-level binning; the classic single-level policy has to round up to the next power of 2.
+O1HEAP_PRIVATE size_t fragSizeForAmount(const size_t amount)
+{
+#if O1HEAP_SUBBIN_BITS > 0
+    return (amount + O1HEAP_ALIGNMENT + (FRAGMENT_SIZE_MIN - 1U)) & ~(FRAGMENT_SIZE_MIN - 1U);
+#else
+    return roundUpToPowerOf2(amount + O1HEAP_ALIGNMENT);
+#endif
+}
+
+#if O1HEAP_SUBBIN_BITS > 0
+/// Maps a fragment size expressed in FRAGMENT_SIZE_MIN units onto its sub-bin within the class fl, rounding down.
+/// Classes smaller than the sub-bin count hold exactly one size per sub-bin, so no scaling is needed there.
+O1HEAP_PRIVATE size_t subbinOf(const size_t units, const uint_fast8_t fl)
+{
+    O1HEAP_ASSERT(units >= pow2(fl));
+    const size_t offset = units - pow2(fl);
+    const size_t sl = (fl >= O1HEAP_SUBBIN_BITS) ? (offset >> (fl - (uint_fast8_t) O1HEAP_SUBBIN_BITS)) : offset;
+    O1HEAP_ASSERT(sl < SUBBIN_COUNT);
+    return sl;
+}
+#endif
+
 // ---------------------------------------- FRAGMENT HEADER ACCESSORS ----------------------------------------
 
 O1HEAP_PRIVATE Fragment* fragGetNext(const Fragment* const frag)
@@ -197,7 +543,7 @@ O1HEAP_PRIVATE Fragment* fragGetNext(const Fragment* const frag)
 O1HEAP_PRIVATE Fragment* fragGetPrev(const Fragment* const frag)
 {
     O1HEAP_ASSERT((((size_t) frag) % sizeof(Fragment*)) == 0U);
-    Fragment* const out = (Fragment*) (frag->header.prev_used & ~(uintptr_t) 1U);
+    Fragment* const out = (Fragment*) (frag->header.prev_used & ~FRAGMENT_FLAGS_MASK);
     O1HEAP_ASSERT((((size_t) out) % sizeof(Fragment*)) == 0U);
     return out;
 }
@@ -208,18 +554,65 @@ O1HEAP_PRIVATE bool fragIsUsed(const Fragment* const frag)
     return (frag->header.prev_used & (uintptr_t) 1U) != 0U;
 }
 
+#if O1HEAP_ENABLE_DONATE
+/// Returns the exclusive end of the adopted region containing the given fragment, or NULL if the fragment is in
+/// the primary arena. The loop is bounded by O1HEAP_DONATE_REGIONS, so the lookup cost is a compile-time constant.
+O1HEAP_PRIVATE char* donatedRegionEnd(const O1HeapInstance* const handle, const Fragment* const frag)
+{
+    char* out = NULL;
+    for (size_t i = 0U; (out == NULL) && (i < handle->region_count); i++)
+    {
+        if ((((const char*) frag) >= handle->region_starts[i]) && (((const char*) frag) < handle->region_ends[i]))
+        {
+            out = handle->region_ends[i];
+        }
+    }
+    return out;
+}
+
+/// Returns the first fragment of the chain that follows the chain containing the given fragment: the primary
+/// arena chain is followed by the adopted regions in table order; NULL after the last chain. Full-heap walkers
+/// (iteration, validation, rollback) use this to continue past a chain-terminating NULL next pointer.
+/// The loop is bounded by O1HEAP_DONATE_REGIONS, so the lookup cost is a compile-time constant.
+O1HEAP_PRIVATE Fragment* chainSuccessor(const O1HeapInstance* const handle, const Fragment* const frag)
+{
+    size_t next_region = 0U;  // The primary chain is followed by the first adopted region.
+    for (size_t i = 0U; i < handle->region_count; i++)  // The regions are disjoint: at most one match.
+    {
+        if ((((const char*) frag) >= handle->region_starts[i]) && (((const char*) frag) < handle->region_ends[i]))
+        {
+            next_region = i + 1U;
+        }
+    }
+    return (next_region < handle->region_count) ? (Fragment*) (void*) handle->region_starts[next_region] : NULL;
+}
+#endif
+
 O1HEAP_PRIVATE size_t fragGetSize(const O1HeapInstance* const handle, const Fragment* const frag)
 {
     O1HEAP_ASSERT((((size_t) frag) % sizeof(Fragment*)) == 0U);
-    O1HEAP_ASSERT(((size_t) frag) >= (((size_t) handle) + INSTANCE_SIZE_PADDED));
     O1HEAP_ASSERT((((size_t) fragGetNext(frag)) % sizeof(Fragment*)) == 0U);
     O1HEAP_ASSERT((((size_t) fragGetPrev(frag)) % sizeof(Fragment*)) == 0U);
 
+    // The chain of an adopted region terminates at its own end pointer rather than at the primary arena_end.
+#if O1HEAP_ENABLE_DONATE
+    const char* const region_end = donatedRegionEnd(handle, frag);
+    const char* const chain_end  = (region_end != NULL) ? region_end : handle->arena_end;
+    O1HEAP_ASSERT((((size_t) frag) >= (((size_t) handle) + INSTANCE_SIZE_PADDED)) || (region_end != NULL));
+#else
+    const char* const chain_end = handle->arena_end;
+    O1HEAP_ASSERT(((size_t) frag) >= (((size_t) handle) + INSTANCE_SIZE_PADDED));
+#endif
+
     const size_t sz = (frag->header.next != NULL) ? (size_t) (((const char*) frag->header.next) - ((const char*) frag))
-                                                  : (size_t) (handle->arena_end - ((const char*) frag));
+                                                  : (size_t) (chain_end - ((const char*) frag));
 
     O1HEAP_ASSERT(sz >= FRAGMENT_SIZE_MIN);
-    O1HEAP_ASSERT(sz <= handle->diagnostics.capacity);
+    // The uncommitted-tail fragment of a lazily initialized arena is the only one allowed to exceed the capacity,
+    // because the capacity covers the committed part only; see o1heapInitLazy(). A donated-away fragment is exempt
+    // for the same reason: the donor's capacity no longer covers it; see o1heapDonate().
+    O1HEAP_ASSERT((sz <= handle->diagnostics.capacity) || (frag == handle->uncommitted) ||
+                  ((frag->header.prev_used & FRAGMENT_FLAG_DONATED) != 0U));
     O1HEAP_ASSERT((sz % FRAGMENT_SIZE_MIN) == 0U);
     return sz;
 }
@@ -235,7 +628,7 @@ O1HEAP_PRIVATE void fragSetPrev(Fragment* const frag, Fragment* const value)
 {
     O1HEAP_ASSERT((((size_t) frag) % O1HEAP_ALIGNMENT) == 0U);
     O1HEAP_ASSERT((((size_t) value) % O1HEAP_ALIGNMENT) == 0U);
-    frag->header.prev_used = (frag->header.prev_used & (uintptr_t) 1U) | (uintptr_t) value;
+    frag->header.prev_used = (frag->header.prev_used & FRAGMENT_FLAGS_MASK) | (uintptr_t) value;
 }
 
 O1HEAP_PRIVATE void fragSetUsed(Fragment* const frag, const bool value)
@@ -251,6 +644,63 @@ O1HEAP_PRIVATE void fragSetUsed(Fragment* const frag, const bool value)
     }
 }
 
+#if O1HEAP_ENABLE_MARK_RELEASE
+O1HEAP_PRIVATE bool fragIsSpeculative(const Fragment* const frag)
+{
+    O1HEAP_ASSERT((((size_t) frag) % sizeof(Fragment*)) == 0U);
+    return (frag->header.prev_used & (uintptr_t) 2U) != 0U;
+}
+
+O1HEAP_PRIVATE void fragSetSpeculative(Fragment* const frag, const bool value)
+{
+    O1HEAP_ASSERT((((size_t) frag) % O1HEAP_ALIGNMENT) == 0U);
+    if (value)
+    {
+        frag->header.prev_used |= (uintptr_t) 2U;
+    }
+    else
+    {
+        frag->header.prev_used &= ~(uintptr_t) 2U;
+    }
+}
+#endif
+
+#if O1HEAP_ENABLE_RESERVE
+O1HEAP_PRIVATE bool fragIsReserved(const Fragment* const frag)
+{
+    O1HEAP_ASSERT((((size_t) frag) % sizeof(Fragment*)) == 0U);
+    return (frag->header.prev_used & (uintptr_t) 4U) != 0U;
+}
+
+O1HEAP_PRIVATE void fragSetReserved(Fragment* const frag, const bool value)
+{
+    O1HEAP_ASSERT((((size_t) frag) % O1HEAP_ALIGNMENT) == 0U);
+    if (value)
+    {
+        frag->header.prev_used |= (uintptr_t) 4U;
+    }
+    else
+    {
+        frag->header.prev_used &= ~(uintptr_t) 4U;
+    }
+}
+#endif
+
+#if O1HEAP_ENABLE_DONATE
+O1HEAP_PRIVATE void fragSetDonated(Fragment* const frag, const bool value)
+{
+    O1HEAP_ASSERT((((size_t) frag) % O1HEAP_ALIGNMENT) == 0U);
+    if (value)
+    {
+        frag->header.prev_used |= (uintptr_t) 8U;
+    }
+    else
+    {
+        frag->header.prev_used &= ~(uintptr_t) 8U;
+    }
+}
+#endif
+
 // ---------------------------------------- FRAGMENT MANAGEMENT ----------------------------------------
 
 /// Links two fragments so that their next/prev pointers point to each other; left goes before right.
@@ -266,7 +716,7 @@ O1HEAP_PRIVATE void interlink(Fragment* const left, Fragment* const right)
     }
 }
 
-/// Adds a new fragment into the appropriate bin and updates the lookup mask.
+/// Adds a new fragment into the appropriate bin and updates the lookup mask(s).
 O1HEAP_PRIVATE void rebin(O1HeapInstance* const handle, Fragment* const fragment, const size_t fragment_size)
 {
     O1HEAP_ASSERT(handle != NULL);
@@ -274,16 +724,28 @@ O1HEAP_PRIVATE void rebin(O1HeapInstance* const handle, Fragment* const fragment
     O1HEAP_ASSERT((fragment_size % FRAGMENT_SIZE_MIN) == 0U);
     const uint_fast8_t idx = log2Floor(fragment_size / FRAGMENT_SIZE_MIN);  // Round DOWN when inserting.
     O1HEAP_ASSERT(idx < NUM_BINS_MAX);
+#if O1HEAP_SUBBIN_BITS > 0
+    const size_t sl   = subbinOf(fragment_size / FRAGMENT_SIZE_MIN, idx);
+    const size_t slot = (((size_t) idx) << O1HEAP_SUBBIN_BITS) + sl;
+#else
+    const size_t slot = idx;
+#endif
     // Add the new fragment to the beginning of the bin list.
     // I.e., each allocation will be returning the most-recently-used fragment -- good for caching.
-    fragment->next_free = handle->bins[idx];
+    fragment->next_free = handle->bins[slot];
     fragment->prev_free = NULL;
-    if (O1HEAP_LIKELY(handle->bins[idx] != NULL))
+    if (O1HEAP_LIKELY(handle->bins[slot] != NULL))
     {
-        handle->bins[idx]->prev_free = fragment;
+        handle->bins[slot]->prev_free = fragment;
     }
-    handle->bins[idx] = fragment;
+    handle->bins[slot] = fragment;
+#if O1HEAP_SUBBIN_BITS > 0
+    handle->subbin_masks[idx] |= pow2((uint_fast8_t) sl);
+#endif
     handle->nonempty_bin_mask |= pow2(idx);
+#if O1HEAP_TELEMETRY
+    handle->bin_fragment_counts[idx]++;
+#endif
 }
 
 /// Removes the specified fragment from its bin.
@@ -294,6 +756,12 @@ O1HEAP_PRIVATE void unbin(O1HeapInstance* const handle, const Fragment* const fr
     O1HEAP_ASSERT((fragment_size % FRAGMENT_SIZE_MIN) == 0U);
     const uint_fast8_t idx = log2Floor(fragment_size / FRAGMENT_SIZE_MIN);  // Round DOWN when removing.
     O1HEAP_ASSERT(idx < NUM_BINS_MAX);
+#if O1HEAP_SUBBIN_BITS > 0
+    const size_t sl   = subbinOf(fragment_size / FRAGMENT_SIZE_MIN, idx);
+    const size_t slot = (((size_t) idx) << O1HEAP_SUBBIN_BITS) + sl;
+#else
+    const size_t slot = idx;
+#endif
     // Remove the bin from the free fragment list.
     if (O1HEAP_LIKELY(fragment->next_free != NULL))
     {
@@ -304,119 +772,743 @@ O1HEAP_PRIVATE void unbin(O1HeapInstance* const handle, const Fragment* const fr
         fragment->prev_free->next_free = fragment->next_free;
     }
     // Update the bin header.
-    if (O1HEAP_LIKELY(handle->bins[idx] == fragment))
+    if (O1HEAP_LIKELY(handle->bins[slot] == fragment))
     {
         O1HEAP_ASSERT(fragment->prev_free == NULL);
-        handle->bins[idx] = fragment->next_free;
-        if (O1HEAP_LIKELY(handle->bins[idx] == NULL))
+        handle->bins[slot] = fragment->next_free;
+        if (O1HEAP_LIKELY(handle->bins[slot] == NULL))
         {
+#if O1HEAP_SUBBIN_BITS > 0
+            handle->subbin_masks[idx] &= ~pow2((uint_fast8_t) sl);
+            if (O1HEAP_LIKELY(handle->subbin_masks[idx] == 0U))
+            {
+                handle->nonempty_bin_mask &= ~pow2(idx);
+            }
+#else
             handle->nonempty_bin_mask &= ~pow2(idx);
+#endif
         }
     }
+#if O1HEAP_TELEMETRY
+    O1HEAP_ASSERT(handle->bin_fragment_counts[idx] > 0U);  // Heap corruption check.
+    handle->bin_fragment_counts[idx]--;
+#endif
 }
 
-// ---------------------------------------- PUBLIC API IMPLEMENTATION ----------------------------------------
-
-const size_t o1heapMinArenaSize = INSTANCE_SIZE_PADDED + FRAGMENT_SIZE_MIN;
+#if O1HEAP_COLOR_LOOKAHEAD > 0
+/// Maps a fragment onto its cache color, i.e., the index of the L1 set its first line lands in.
+O1HEAP_PRIVATE size_t fragColor(const Fragment* const frag)
+{
+    return (((size_t) frag) >> O1HEAP_COLOR_SHIFT) & (O1HEAP_COLOR_COUNT - 1U);
+}
+#endif
 
-O1HeapInstance* o1heapInit(void* const base, const size_t size)
+/// Locates the smallest free fragment that can accommodate the specified allocation size without removing it
+/// from its bin; returns NULL if no such fragment exists. The time complexity is constant: the classic
+/// single-level policy needs one bitmask scan, the two-level (sub-bin) policy needs at most two.
+/// With cache coloring enabled, the choice among the leading entries of the selected list is biased away from
+/// the color of the previously served fragment, which mutates the bookkeeping (hence the non-const handle).
+O1HEAP_PRIVATE Fragment* binFind(O1HeapInstance* const handle, const size_t alloc_size)
 {
-    O1HeapInstance* out = NULL;
-    if ((base != NULL) && ((((size_t) base) % O1HEAP_ALIGNMENT) == 0U) && (size >= o1heapMinArenaSize))
+    O1HEAP_ASSERT((alloc_size % FRAGMENT_SIZE_MIN) == 0U);
+    Fragment* frag = NULL;
+#if O1HEAP_SUBBIN_BITS > 0
+    size_t       units = alloc_size / FRAGMENT_SIZE_MIN;
+    uint_fast8_t fl    = log2Floor(units);
+    if (fl >= O1HEAP_SUBBIN_BITS)
     {
-        // Allocate the core heap metadata structure in the beginning of the arena.
-        O1HEAP_ASSERT(((size_t) base) % sizeof(O1HeapInstance*) == 0U);
-        out                    = (O1HeapInstance*) base;
-        out->nonempty_bin_mask = 0U;
-        for (size_t i = 0; i < NUM_BINS_MAX; i++)
-        {
-            out->bins[i] = NULL;
-        }
-
-        // Limit and align the capacity.
-        size_t capacity = size - INSTANCE_SIZE_PADDED;
-        if (capacity > FRAGMENT_SIZE_MAX)
+        // TLSF mapping search: round the request up to the next sub-bin boundary so that any fragment found in
+        // the resulting sub-bin is guaranteed to fit. The rounding may carry into the next power of 2.
+        units += pow2(fl - (uint_fast8_t) O1HEAP_SUBBIN_BITS) - 1U;
+        fl = log2Floor(units);
+    }
+    const size_t sl            = subbinOf(units, fl);
+    const size_t sl_candidates = handle->subbin_masks[fl] & ~(pow2((uint_fast8_t) sl) - 1U);
+    if (O1HEAP_LIKELY(sl_candidates != 0U))
+    {
+        const size_t sl_lowest = sl_candidates & ~(sl_candidates - 1U);  // Clear all bits but the lowest.
+        frag = handle->bins[(((size_t) fl) << O1HEAP_SUBBIN_BITS) + log2Floor(sl_lowest)];
+    }
+    else
+    {
+        // No fit in the requested class; take the smallest fragment from the smallest higher class.
+        // The shift below overflows into an empty mask gracefully if the requested class is the topmost one.
+        const size_t fl_candidates = handle->nonempty_bin_mask & ~((pow2(fl) << 1U) - 1U);
+        if (O1HEAP_UNLIKELY(fl_candidates == 0U))
         {
-            capacity = FRAGMENT_SIZE_MAX;
+            return NULL;  // MISRA: Early return simplifies control flow.
         }
-        while ((capacity % FRAGMENT_SIZE_MIN) != 0)
+        const uint_fast8_t fl_pick = log2Floor(fl_candidates & ~(fl_candidates - 1U));
+        const size_t       sl_mask = handle->subbin_masks[fl_pick];
+        O1HEAP_ASSERT(sl_mask != 0U);
+        frag = handle->bins[(((size_t) fl_pick) << O1HEAP_SUBBIN_BITS) + log2Floor(sl_mask & ~(sl_mask - 1U))];
+    }
+#else
+    // Since alloc_size and FRAGMENT_SIZE_MIN are both powers of 2, the quotient is also a power of 2,
+    // meaning log2Ceil == log2Floor. We use log2Floor because it is slightly faster (no x-1 before CLZ).
+    const size_t alloc_bins = alloc_size / FRAGMENT_SIZE_MIN;
+    O1HEAP_ASSERT((alloc_bins & (alloc_bins - 1U)) == 0U);         // Is power of 2 => log2Ceil == log2Floor.
+    const uint_fast8_t optimal_bin_index = log2Floor(alloc_bins);  // Should be ceil, but in this case identical.
+    O1HEAP_ASSERT(optimal_bin_index < NUM_BINS_MAX);
+    const size_t candidate_bin_mask = ~(pow2(optimal_bin_index) - 1U);
+
+    // Find the smallest non-empty bin we can use.
+    const size_t suitable_bins     = handle->nonempty_bin_mask & candidate_bin_mask;
+    const size_t smallest_bin_mask = suitable_bins & ~(suitable_bins - 1U);  // Clear all bits but the lowest.
+    if (O1HEAP_UNLIKELY(smallest_bin_mask == 0U))
+    {
+        return NULL;  // MISRA: Early return simplifies control flow.
+    }
+    O1HEAP_ASSERT((smallest_bin_mask & (smallest_bin_mask - 1U)) == 0U);  // Is power of 2.
+    const uint_fast8_t bin_index = log2Floor(smallest_bin_mask);
+    O1HEAP_ASSERT(bin_index >= optimal_bin_index);
+    O1HEAP_ASSERT(bin_index < NUM_BINS_MAX);
+    frag = handle->bins[bin_index];
+#endif
+    // The bin we found shall not be empty, otherwise it's a state divergence (memory corruption?).
+    O1HEAP_ASSERT(frag != NULL);
+    O1HEAP_ASSERT(!fragIsUsed(frag));
+#if O1HEAP_COLOR_LOOKAHEAD > 0
+    // Every entry of the selected list fits the request, so any of them may be served; prefer the first one that
+    // maps to a different cache set than the previous allocation. If the leading entries are all of the same
+    // color, the head is served as usual; the scan is bounded by the compile-time lookahead constant.
+    if (O1HEAP_UNLIKELY(fragColor(frag) == handle->last_color))
+    {
+        Fragment* candidate = frag->next_free;
+        for (size_t i = 1U; (i < (size_t) O1HEAP_COLOR_LOOKAHEAD) && (candidate != NULL); i++)
         {
-            O1HEAP_ASSERT(capacity > 0U);
-            capacity--;
+            if (fragColor(candidate) != handle->last_color)
+            {
+                frag      = candidate;
+                candidate = NULL;  // A differently colored fragment is found; stop the scan.
+            }
+            else
+            {
+                candidate = candidate->next_free;
+            }
         }
-        O1HEAP_ASSERT((capacity % FRAGMENT_SIZE_MIN) == 0);
-        O1HEAP_ASSERT((capacity >= FRAGMENT_SIZE_MIN) && (capacity <= FRAGMENT_SIZE_MAX));
+    }
+    handle->last_color = fragColor(frag);
+#endif
+    return frag;
+}
 
-        // Initialize the diagnostics.
-        out->diagnostics.capacity          = capacity;
-        out->diagnostics.allocated         = 0U;
-        out->diagnostics.peak_allocated    = 0U;
-        out->diagnostics.peak_request_size = 0U;
-        out->diagnostics.oom_count         = 0U;
+/// Marks the fragment free, updates the diagnostics, merges it with its free neighbors, and rebins the result.
+/// This is the backend of o1heapFree(); the fragment shall be currently used and its size shall be pre-computed.
+O1HEAP_PRIVATE void freeFragment(O1HeapInstance* const handle, Fragment* const frag, const size_t frag_size)
+{
+    // Even if we're going to drop the fragment later, mark it free anyway to prevent double-free.
+    fragSetUsed(frag, false);
+#if O1HEAP_ENABLE_MARK_RELEASE
+    fragSetSpeculative(frag, false);  // A free fragment is never speculative.
+#endif
 
-        // Store the arena end pointer for computing size of the last fragment.
-        char* const arena_start = ((char*) base) + INSTANCE_SIZE_PADDED;
-        out->arena_end          = arena_start + capacity;
+    // Update the diagnostics. It must be done before merging because it invalidates the fragment size information.
+#if O1HEAP_DIAGNOSTICS
+    O1HEAP_ASSERT(handle->diagnostics.allocated >= frag_size);  // Heap corruption check.
+    handle->diagnostics.allocated -= frag_size;
+#endif
 
-        // Initialize the root fragment.
-        Fragment* const frag = (Fragment*) (void*) arena_start;
-        O1HEAP_ASSERT((((size_t) frag) % O1HEAP_ALIGNMENT) == 0U);
-        fragSetNext(frag, NULL);
-        fragSetPrev(frag, NULL);
-        fragSetUsed(frag, false);
-        frag->next_free = NULL;
-        frag->prev_free = NULL;
-        O1HEAP_ASSERT(fragGetSize(out, frag) == capacity);
-        rebin(out, frag, capacity);
-        O1HEAP_ASSERT(out->nonempty_bin_mask != 0U);
+    // Merge with siblings and insert the returned fragment into the appropriate bin and update metadata.
+    Fragment* const prev       = fragGetPrev(frag);
+    Fragment* const next       = fragGetNext(frag);
+    const bool      join_left  = (prev != NULL) && (!fragIsUsed(prev));
+    const bool      join_right = (next != NULL) && (!fragIsUsed(next));
+    if (join_left && join_right)  // [ prev ][ this ][ next ] => [ ------- prev ------- ]
+    {
+        const size_t prev_size = fragGetSize(handle, prev);
+        const size_t next_size = fragGetSize(handle, next);
+        unbin(handle, prev, prev_size);
+        unbin(handle, next, next_size);
+        interlink(prev, fragGetNext(next));
+        rebin(handle, prev, prev_size + frag_size + next_size);
+#if O1HEAP_TELEMETRY
+        handle->merge_count += 2U;
+#endif
+    }
+    else if (join_left)  // [ prev ][ this ][ next ] => [ --- prev --- ][ next ]
+    {
+        const size_t prev_size = fragGetSize(handle, prev);
+        unbin(handle, prev, prev_size);
+        interlink(prev, next);
+        rebin(handle, prev, prev_size + frag_size);
+#if O1HEAP_TELEMETRY
+        handle->merge_count++;
+#endif
+    }
+    else if (join_right)  // [ prev ][ this ][ next ] => [ prev ][ --- this --- ]
+    {
+        const size_t next_size = fragGetSize(handle, next);
+        unbin(handle, next, next_size);
+        interlink(frag, fragGetNext(next));
+        rebin(handle, frag, frag_size + next_size);
+#if O1HEAP_TELEMETRY
+        handle->merge_count++;
+#endif
+    }
+    else
+    {
+        rebin(handle, frag, frag_size);
     }
-
-    return out;
 }
 
-void* o1heapAllocate(O1HeapInstance* const handle, const size_t amount)
+#if O1HEAP_ENABLE_DEFRAG
+/// Returns the registration table index of the given user pointer, or O1HEAP_DEFRAG_SLOTS if it is not registered.
+/// The scan is bounded by the compile-time table capacity, hence constant time.
+O1HEAP_PRIVATE size_t relocFind(const O1HeapInstance* const handle, const void* const pointer)
 {
     O1HEAP_ASSERT(handle != NULL);
-    O1HEAP_ASSERT(handle->diagnostics.capacity <= FRAGMENT_SIZE_MAX);
-    void* out = NULL;
-
-    // If the amount approaches approx. SIZE_MAX/2, an undetected integer overflow may occur.
-    // To avoid that, we do not attempt allocation if the amount exceeds the hard limit.
-    // We perform multiple redundant checks to account for a possible unaccounted overflow.
-    if (O1HEAP_LIKELY((amount > 0U) && (amount <= (handle->diagnostics.capacity - O1HEAP_ALIGNMENT))))
+    O1HEAP_ASSERT(pointer != NULL);
+    size_t out = O1HEAP_DEFRAG_SLOTS;
+    for (size_t i = 0U; (i < O1HEAP_DEFRAG_SLOTS) && (out == O1HEAP_DEFRAG_SLOTS); i++)
     {
-        // Add the header size and align the allocation size to the power of 2.
-        // See "Timing-Predictable Memory Allocation In Hard Real-Time Systems", Herter, page 27.
-        const size_t alloc_size = roundUpToPowerOf2(amount + O1HEAP_ALIGNMENT);
-        O1HEAP_ASSERT(alloc_size <= FRAGMENT_SIZE_MAX);
-        O1HEAP_ASSERT(alloc_size >= FRAGMENT_SIZE_MIN);
-        O1HEAP_ASSERT(alloc_size >= amount + O1HEAP_ALIGNMENT);
-        O1HEAP_ASSERT((alloc_size & (alloc_size - 1U)) == 0U);  // Is power of 2.
-
-        // Since alloc_size and FRAGMENT_SIZE_MIN are both powers of 2, the quotient is also a power of 2,
-        // meaning log2Ceil == log2Floor. We use log2Floor because it is slightly faster (no x-1 before CLZ).
-        const size_t alloc_bins = alloc_size / FRAGMENT_SIZE_MIN;
-        O1HEAP_ASSERT((alloc_bins & (alloc_bins - 1U)) == 0U);         // Is power of 2 => log2Ceil == log2Floor.
-        const uint_fast8_t optimal_bin_index = log2Floor(alloc_bins);  // Should be ceil, but in this case identical.
-        O1HEAP_ASSERT(optimal_bin_index < NUM_BINS_MAX);
-        const size_t candidate_bin_mask = ~(pow2(optimal_bin_index) - 1U);
-
-        // Find the smallest non-empty bin we can use.
-        const size_t suitable_bins     = handle->nonempty_bin_mask & candidate_bin_mask;
-        const size_t smallest_bin_mask = suitable_bins & ~(suitable_bins - 1U);  // Clear all bits but the lowest.
-        if (O1HEAP_LIKELY(smallest_bin_mask != 0))
+        if (handle->reloc_pointers[i] == pointer)
         {
-            O1HEAP_ASSERT((smallest_bin_mask & (smallest_bin_mask - 1U)) == 0U);  // Is power of 2.
-            const uint_fast8_t bin_index = log2Floor(smallest_bin_mask);
-            O1HEAP_ASSERT(bin_index >= optimal_bin_index);
-            O1HEAP_ASSERT(bin_index < NUM_BINS_MAX);
+            out = i;
+        }
+    }
+    return out;
+}
 
-            // The bin we found shall not be empty, otherwise it's a state divergence (memory corruption?).
-            Fragment* const frag = handle->bins[bin_index];
-            O1HEAP_ASSERT(frag != NULL);
-            const size_t frag_size = fragGetSize(handle, frag);
-            O1HEAP_ASSERT(frag_size >= alloc_size);
-            O1HEAP_ASSERT((frag_size % FRAGMENT_SIZE_MIN) == 0U);
+/// Removes the relocation registration of the given user pointer, if any. Invoked from the free path so that a
+/// registration never outlives its object.
+O1HEAP_PRIVATE void relocRemove(O1HeapInstance* const handle, const void* const pointer)
+{
+    const size_t idx = relocFind(handle, pointer);
+    if (O1HEAP_UNLIKELY(idx < O1HEAP_DEFRAG_SLOTS))
+    {
+        handle->reloc_pointers[idx]  = NULL;
+        handle->reloc_callbacks[idx] = NULL;
+    }
+}
+
+/// Re-points the relocation registration of the given user pointer after the allocator has moved the object.
+/// The callback is not invoked here: reallocation is initiated by the owner, who receives the new pointer directly.
+O1HEAP_PRIVATE void relocUpdate(O1HeapInstance* const handle, const void* const old_pointer, void* const new_pointer)
+{
+    const size_t idx = relocFind(handle, old_pointer);
+    if (O1HEAP_UNLIKELY(idx < O1HEAP_DEFRAG_SLOTS))
+    {
+        handle->reloc_pointers[idx] = new_pointer;
+    }
+}
+#endif
+
+/// Returns truth if the address points at a properly aligned fragment slot inside the committed arena or,
+/// with O1HEAP_ENABLE_DONATE, inside one of the adopted regions. The comparisons are arranged so that they
+/// cannot overflow even for wild values near SIZE_MAX; the region scan is bounded by O1HEAP_DONATE_REGIONS.
+O1HEAP_PRIVATE bool addressIsFragment(const O1HeapInstance* const handle, const size_t address)
+{
+    const size_t arena_start = ((size_t) handle) + INSTANCE_SIZE_PADDED;
+    const size_t arena_end   = (size_t) handle->arena_end;
+    bool         valid       = (address >= arena_start) && (address <= (arena_end - FRAGMENT_SIZE_MIN)) &&
+                 (((address - arena_start) % FRAGMENT_SIZE_MIN) == 0U);
+#if O1HEAP_ENABLE_DONATE
+    for (size_t i = 0U; (!valid) && (i < handle->region_count); i++)
+    {
+        const size_t start = (size_t) handle->region_starts[i];
+        const size_t end   = (size_t) handle->region_ends[i];
+        valid              = (address >= start) && (address <= (end - FRAGMENT_SIZE_MIN)) &&
+                (((address - start) % FRAGMENT_SIZE_MIN) == 0U);
+    }
+#endif
+    return valid;
+}
+
+#if O1HEAP_ENABLE_HARDENING
+/// Constant-time structural validation of a pointer passed to o1heapFree(): returns falsity unless the argument
+/// looks like a currently allocated fragment of this heap, rejecting double-frees and wild/foreign pointers.
+/// Only raw header reads are used here because the asserting accessors cannot be entered until the checks pass.
+/// The neighbor back-link checks effectively act as a distributed canary: a fabricated or stale pointer cannot
+/// be interlinked consistently with both of its neighbors.
+O1HEAP_PRIVATE bool fragValidate(const O1HeapInstance* const handle, const Fragment* const frag)
+{
+    const size_t address = (size_t) frag;
+
+    // Range and alignment checks; until these pass, the header must not be dereferenced.
+    bool valid = addressIsFragment(handle, address);
+    if (valid)
+    {
+        // The fragment shall be marked used (catches double-free) and shall not be owned by the allocator itself
+        // (the uncommitted-tail fragment and, with O1HEAP_ENABLE_DONATE, a donated-away fragment).
+        valid = ((frag->header.prev_used & (uintptr_t) 1U) != 0U) && (frag != handle->uncommitted) &&
+                ((frag->header.prev_used & FRAGMENT_FLAG_DONATED) == 0U);
+
+        // The neighbor pointers shall be either NULL or properly aligned fragments within the heap.
+        const size_t next = (size_t) frag->header.next;
+        const size_t prev = (size_t) (frag->header.prev_used & ~FRAGMENT_FLAGS_MASK);
+        valid             = valid && ((next == 0U) || ((next >= (address + FRAGMENT_SIZE_MIN)) &&
+                                           addressIsFragment(handle, next) &&
+                                           (((next - address) % FRAGMENT_SIZE_MIN) == 0U)));
+        valid             = valid && ((prev == 0U) || ((prev <= (address - FRAGMENT_SIZE_MIN)) &&
+                                           addressIsFragment(handle, prev) &&
+                                           (((address - prev) % FRAGMENT_SIZE_MIN) == 0U)));
+        if (valid)
+        {
+            // The neighbors shall link back to this fragment; safe to dereference only after the checks above.
+            const Fragment* const next_frag = (const Fragment*) (const void*) next;
+            const Fragment* const prev_frag = (const Fragment*) (const void*) prev;
+            valid = ((next == 0U) || ((next_frag->header.prev_used & ~FRAGMENT_FLAGS_MASK) == (uintptr_t) address)) &&
+                    ((prev == 0U) || (((size_t) prev_frag->header.next) == address));
+        }
+    }
+    return valid;
+}
+#endif
+
+/// Deep structural validation of one fragment for o1heapValidateFull(): verifies the neighbor interlinking,
+/// the size invariants, and -- for free fragments -- the segregated-list linkage and the bin lookup masks.
+/// Only raw header reads are used, and every pointer is bounds-checked before it is dereferenced, so the check
+/// never faults or trips an assertion even on a corrupted heap; it simply reports falsity.
+O1HEAP_PRIVATE bool validateFragmentDeep(const O1HeapInstance* const handle, const Fragment* const frag)
+{
+    const size_t address = (size_t) frag;
+
+    // Range and alignment of the fragment itself.
+    bool valid = addressIsFragment(handle, address);
+    if (valid)
+    {
+        // The neighbor pointers shall be either NULL or properly aligned fragments on the correct side.
+        const size_t next = (size_t) frag->header.next;
+        const size_t prev = (size_t) (frag->header.prev_used & ~FRAGMENT_FLAGS_MASK);
+        const bool   used = (frag->header.prev_used & (uintptr_t) 1U) != 0U;
+        valid             = ((next == 0U) || ((next >= (address + FRAGMENT_SIZE_MIN)) &&
+                                  addressIsFragment(handle, next) &&
+                                  (((next - address) % FRAGMENT_SIZE_MIN) == 0U)));
+        valid             = valid && ((prev == 0U) || ((prev <= (address - FRAGMENT_SIZE_MIN)) &&
+                                           addressIsFragment(handle, prev) &&
+                                           (((address - prev) % FRAGMENT_SIZE_MIN) == 0U)));
+        if (valid)
+        {
+            const Fragment* const next_frag = (const Fragment*) (const void*) next;
+            const Fragment* const prev_frag = (const Fragment*) (const void*) prev;
+
+            // Interlinking symmetry: both neighbors shall link back to this fragment.
+            valid = ((next == 0U) || ((next_frag->header.prev_used & ~FRAGMENT_FLAGS_MASK) == (uintptr_t) address)) &&
+                    ((prev == 0U) || (((size_t) prev_frag->header.next) == address));
+
+            // The chain of an adopted region terminates at its own end pointer rather than at the primary one.
+            size_t chain_end = (size_t) handle->arena_end;
+#if O1HEAP_ENABLE_DONATE
+            {
+                const char* const region_end = donatedRegionEnd(handle, frag);
+                if (region_end != NULL)
+                {
+                    chain_end = (size_t) region_end;
+                }
+            }
+#endif
+            // Size invariants. Only the uncommitted-tail fragment and a donated-away fragment (whose memory is no
+            // longer covered by the donor's capacity; see o1heapDonate()) may exceed the committed capacity.
+            const size_t sz = (next != 0U) ? (next - address) : (chain_end - address);
+            valid           = valid && (sz >= FRAGMENT_SIZE_MIN) && ((sz % FRAGMENT_SIZE_MIN) == 0U) &&
+                    ((sz <= handle->diagnostics.capacity) || (frag == handle->uncommitted) ||
+                     ((frag->header.prev_used & FRAGMENT_FLAG_DONATED) != 0U));
+
+            if (valid && (!used))
+            {
+                // Adjacent free fragments shall have been merged on the free path.
+                valid = (next == 0U) || ((next_frag->header.prev_used & (uintptr_t) 1U) != 0U);
+
+                // The bin lookup mask(s) shall cover the class of this fragment.
+                const uint_fast8_t idx = log2Floor(sz / FRAGMENT_SIZE_MIN);
+#if O1HEAP_SUBBIN_BITS > 0
+                const size_t sl   = subbinOf(sz / FRAGMENT_SIZE_MIN, idx);
+                const size_t slot = (((size_t) idx) << O1HEAP_SUBBIN_BITS) + sl;
+                valid             = valid && ((handle->subbin_masks[idx] & pow2((uint_fast8_t) sl)) != 0U);
+#else
+                const size_t slot = idx;
+#endif
+                valid = valid && ((handle->nonempty_bin_mask & pow2(idx)) != 0U);
+
+                // Segregated-list linkage: the list neighbors shall link back; a fragment with no predecessor
+                // shall be the head of the bin its size maps onto. The list pointers live in the payload area,
+                // so they are bounds-checked before dereferencing like everything else here.
+                const Fragment* const next_free = frag->next_free;
+                const Fragment* const prev_free = frag->prev_free;
+                valid                           = valid &&
+                        ((next_free == NULL) ||
+                         (addressIsFragment(handle, (size_t) next_free) && (next_free->prev_free == frag)));
+                if (prev_free == NULL)
+                {
+                    valid = valid && (handle->bins[slot] == frag);
+                }
+                else
+                {
+                    valid = valid && addressIsFragment(handle, (size_t) prev_free) && (prev_free->next_free == frag);
+                }
+            }
+        }
+    }
+    return valid;
+}
+
+#if O1HEAP_MAGAZINE_BINS > 0
+/// Returns all fragments cached in the specified magazine back into the bins through the regular free path.
+/// The cost is bounded by O1HEAP_MAGAZINE_DEPTH, so the WCET remains constant for a given configuration.
+O1HEAP_PRIVATE void magazineFlush(O1HeapInstance* const handle, const uint_fast8_t idx)
+{
+    O1HEAP_ASSERT(idx < O1HEAP_MAGAZINE_BINS);
+    Fragment* frag              = handle->magazine_heads[idx];
+    handle->magazine_heads[idx] = NULL;
+    handle->magazine_sizes[idx] = 0U;
+    while (frag != NULL)
+    {
+        Fragment* const next = frag->next_free;  // Sample before the free because the merge overwrites next_free.
+        O1HEAP_ASSERT(fragIsUsed(frag));
+        freeFragment(handle, frag, fragGetSize(handle, frag));
+        frag = next;
+    }
+}
+#endif
+
+// ---------------------------------------- PUBLIC API IMPLEMENTATION ----------------------------------------
+
+const size_t o1heapMinArenaSize = INSTANCE_SIZE_PADDED + FRAGMENT_SIZE_MIN;
+
+O1HeapInstance* o1heapInit(void* const base, const size_t size)
+{
+    return o1heapInitLazy(base, size, SIZE_MAX);
+}
+
+O1HeapInstance* o1heapInitLazy(void* const base, const size_t size, const size_t initial_committed)
+{
+    O1HeapInstance* out = NULL;
+    if ((base != NULL) && ((((size_t) base) % O1HEAP_ALIGNMENT) == 0U) && (size >= o1heapMinArenaSize))
+    {
+        // Allocate the core heap metadata structure in the beginning of the arena.
+        O1HEAP_ASSERT(((size_t) base) % sizeof(O1HeapInstance*) == 0U);
+        out                    = (O1HeapInstance*) base;
+        out->nonempty_bin_mask = 0U;
+        for (size_t i = 0; i < NUM_LISTS_TOTAL; i++)
+        {
+            out->bins[i] = NULL;
+        }
+#if O1HEAP_SUBBIN_BITS > 0
+        for (size_t i = 0; i < NUM_BINS_MAX; i++)
+        {
+            out->subbin_masks[i] = 0U;
+        }
+#endif
+
+        // Limit and align the capacity. FRAGMENT_SIZE_MIN is a power of two (statically asserted above),
+        // so the downward alignment is plain mask arithmetic; no loop is needed.
+        size_t capacity = size - INSTANCE_SIZE_PADDED;
+        if (capacity > FRAGMENT_SIZE_MAX)
+        {
+            capacity = FRAGMENT_SIZE_MAX;
+        }
+        capacity &= ~(FRAGMENT_SIZE_MIN - 1U);
+        O1HEAP_ASSERT((capacity % FRAGMENT_SIZE_MIN) == 0);
+        O1HEAP_ASSERT((capacity >= FRAGMENT_SIZE_MIN) && (capacity <= FRAGMENT_SIZE_MAX));
+
+        // Limit and align the initially committed part of the arena. Only this part is immediately usable;
+        // the rest is covered by a used-marked fragment owned by the allocator until released via o1heapExtend().
+        // This way the allocator never touches the uncommitted memory, keeping its pages unfaulted.
+        size_t committed = initial_committed;
+        if (committed >= capacity)
+        {
+            committed = capacity;
+        }
+        else
+        {
+            if (committed < FRAGMENT_SIZE_MIN)
+            {
+                committed = FRAGMENT_SIZE_MIN;
+            }
+            committed = (committed + (FRAGMENT_SIZE_MIN - 1U)) & ~(FRAGMENT_SIZE_MIN - 1U);  // Round up; can't overflow.
+        }
+        O1HEAP_ASSERT((committed % FRAGMENT_SIZE_MIN) == 0U);
+        O1HEAP_ASSERT((committed >= FRAGMENT_SIZE_MIN) && (committed <= capacity));
+
+        // Initialize the diagnostics. The reported capacity covers only the committed part; it grows on extension.
+        out->diagnostics.capacity          = committed;
+        out->diagnostics.allocated         = 0U;
+        out->diagnostics.peak_allocated    = 0U;
+        out->diagnostics.peak_request_size = 0U;
+        out->diagnostics.oom_count         = 0U;
+        out->diagnostics.bad_free_count    = 0U;
+
+#if O1HEAP_ENABLE_DEFERRED_FREE
+        out->deferred_free_head = NULL;
+#endif
+
+#if O1HEAP_MAGAZINE_BINS > 0
+        for (size_t i = 0; i < O1HEAP_MAGAZINE_BINS; i++)
+        {
+            out->magazine_heads[i] = NULL;
+            out->magazine_sizes[i] = 0U;
+        }
+#endif
+
+#if O1HEAP_COLOR_LOOKAHEAD > 0
+        out->last_color = 0U;
+#endif
+
+#if O1HEAP_ENABLE_RESERVE
+        out->reserve_head  = NULL;
+        out->reserve_count = 0U;
+#endif
+
+#if O1HEAP_ENABLE_DONATE
+        for (size_t i = 0; i < O1HEAP_DONATE_REGIONS; i++)
+        {
+            out->region_starts[i] = NULL;
+            out->region_ends[i]   = NULL;
+        }
+        out->region_count = 0U;
+#endif
+
+#if O1HEAP_TELEMETRY
+        for (size_t i = 0; i < NUM_BINS_MAX; i++)
+        {
+            out->bin_fragment_counts[i] = 0U;
+        }
+        out->split_count = 0U;
+        out->merge_count = 0U;
+#endif
+
+#if O1HEAP_ENABLE_MARK_RELEASE
+        out->mark_active = false;
+#endif
+
+#if O1HEAP_ENABLE_DEFRAG
+        for (size_t i = 0; i < O1HEAP_DEFRAG_SLOTS; i++)
+        {
+            out->reloc_pointers[i]  = NULL;
+            out->reloc_callbacks[i] = NULL;
+        }
+#endif
+
+#if O1HEAP_ENABLE_SCRUB
+        for (size_t i = 0; i < NUM_BINS_MAX; i++)
+        {
+            out->zeroed_bins[i] = NULL;
+        }
+        out->zeroed_demand_mask = 0U;
+        out->scrub_frag         = NULL;
+        out->scrub_done         = 0U;
+#endif
+
+        // Store the arena end pointer for computing size of the last fragment.
+        char* const arena_start = ((char*) base) + INSTANCE_SIZE_PADDED;
+        out->arena_end          = arena_start + capacity;
+        out->uncommitted        = NULL;
+        out->iterate_cursor     = NULL;
+        out->validate_cursor    = NULL;
+
+        // Initialize the root fragment covering the committed part of the arena.
+        Fragment* const frag = (Fragment*) (void*) arena_start;
+        O1HEAP_ASSERT((((size_t) frag) % O1HEAP_ALIGNMENT) == 0U);
+        fragSetNext(frag, NULL);
+        fragSetPrev(frag, NULL);
+        fragSetUsed(frag, false);
+        frag->next_free = NULL;
+        frag->prev_free = NULL;
+        if (committed < capacity)
+        {
+            // Cover the uncommitted tail with a used-marked fragment so the regular machinery never touches it.
+            // Only its header is written, which faults in a single page at the commitment boundary.
+            Fragment* const resv = (Fragment*) (void*) (arena_start + committed);
+            fragSetNext(resv, NULL);
+            fragSetPrev(resv, frag);
+            fragSetUsed(resv, true);
+#if O1HEAP_ENABLE_MARK_RELEASE
+            fragSetSpeculative(resv, false);  // It shall never be reclaimed by o1heapRelease().
+#endif
+#if O1HEAP_ENABLE_RESERVE
+            fragSetReserved(resv, false);  // The header is written over arbitrary data; clear the flag.
+#endif
+#if O1HEAP_ENABLE_DONATE
+            fragSetDonated(resv, false);  // Same: the garbage in the flag bit shall not survive.
+#endif
+            fragSetNext(frag, resv);
+            out->uncommitted = resv;
+            O1HEAP_ASSERT(fragGetSize(out, resv) == (capacity - committed));
+        }
+        O1HEAP_ASSERT(fragGetSize(out, frag) == committed);
+        rebin(out, frag, committed);
+        O1HEAP_ASSERT(out->nonempty_bin_mask != 0U);
+    }
+
+    return out;
+}
+
+size_t o1heapExtend(O1HeapInstance* const handle, const size_t additional)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    Fragment* const resv = handle->uncommitted;
+    if (O1HEAP_UNLIKELY((resv == NULL) || (additional == 0U)))
+    {
+        return 0U;  // MISRA: Early return simplifies control flow.
+    }
+    const size_t available = fragGetSize(handle, resv);
+    O1HEAP_ASSERT((available % FRAGMENT_SIZE_MIN) == 0U);
+    O1HEAP_ASSERT(available >= FRAGMENT_SIZE_MIN);
+
+    // Round the extension up to the fragment granularity and clamp it to the remaining uncommitted space.
+    size_t delta = additional;
+    if (delta >= available)
+    {
+        delta = available;
+    }
+    else
+    {
+        delta = (delta + (FRAGMENT_SIZE_MIN - 1U)) & ~(FRAGMENT_SIZE_MIN - 1U);  // Round up; can't overflow.
+    }
+    O1HEAP_ASSERT((delta % FRAGMENT_SIZE_MIN) == 0U);
+    O1HEAP_ASSERT((delta >= FRAGMENT_SIZE_MIN) && (delta <= available));
+
+    // Carve the newly committed space off the front of the uncommitted fragment, reusing its header.
+    // If uncommitted space remains, a new header is written at the new boundary, faulting in one page.
+    Fragment* const frag = resv;
+    if (delta < available)
+    {
+        Fragment* const new_resv = (Fragment*) (void*) (((char*) resv) + delta);
+        fragSetNext(new_resv, NULL);
+        fragSetPrev(new_resv, frag);
+        fragSetUsed(new_resv, true);
+#if O1HEAP_ENABLE_MARK_RELEASE
+        fragSetSpeculative(new_resv, false);  // It shall never be reclaimed by o1heapRelease().
+#endif
+#if O1HEAP_ENABLE_RESERVE
+        fragSetReserved(new_resv, false);  // The header is written over arbitrary data; clear the flag.
+#endif
+#if O1HEAP_ENABLE_DONATE
+        fragSetDonated(new_resv, false);  // Same: the garbage in the flag bit shall not survive.
+#endif
+        fragSetNext(frag, new_resv);
+        handle->uncommitted = new_resv;
+    }
+    else
+    {
+        fragSetNext(frag, NULL);
+        handle->uncommitted = NULL;
+    }
+    handle->diagnostics.capacity += delta;
+
+    // Hand the new fragment over to the regular free logic so that it is merged with a free committed tail,
+    // rebinned, and reflected in the telemetry as usual. The allocated counter is bumped first because
+    // freeFragment() treats its argument as a previously allocated fragment.
+#if O1HEAP_DIAGNOSTICS
+    handle->diagnostics.allocated += delta;
+#endif
+    freeFragment(handle, frag, delta);
+    return delta;
+}
+
+#if O1HEAP_ENABLE_DONATE
+size_t o1heapDonate(O1HeapInstance* const from, O1HeapInstance* const to, const size_t min_size)
+{
+    O1HEAP_ASSERT(from != NULL);
+    O1HEAP_ASSERT(to != NULL);
+    O1HEAP_ASSERT(from != to);
+    size_t out = 0U;
+    // The donation is rejected outright if the destination has no free region slot or the request cannot
+    // possibly be satisfied by the source; the overflow guard mirrors the one in o1heapAllocate().
+    if (O1HEAP_LIKELY((to->region_count < O1HEAP_DONATE_REGIONS) &&
+                      (min_size <= (from->diagnostics.capacity - O1HEAP_ALIGNMENT))))
+    {
+        // One minimum-size slot at the front of the donated fragment stays behind in the source as a used-marked
+        // anchor, so the required fragment is one granule larger than the requested gain. The bin lookup is
+        // subject to the same rounding policy as allocation (see fragSizeForAmount()).
+        const size_t needed = larger(min_size, FRAGMENT_SIZE_MIN) + FRAGMENT_SIZE_MIN;
+        if (O1HEAP_LIKELY(needed <= FRAGMENT_SIZE_MAX))
+        {
+            const size_t    lookup = fragSizeForAmount(needed - O1HEAP_ALIGNMENT);
+            Fragment* const frag   = (lookup <= FRAGMENT_SIZE_MAX) ? binFind(from, lookup) : NULL;
+            if (O1HEAP_LIKELY(frag != NULL))
+            {
+                const size_t frag_size = fragGetSize(from, frag);
+                O1HEAP_ASSERT(frag_size >= needed);
+                const size_t gain = frag_size - FRAGMENT_SIZE_MIN;
+                // The source shall remain a functional heap afterwards and the destination shall not overflow
+                // its maximum capacity; otherwise, the donation is rejected and the fragment stays binned.
+                if (O1HEAP_LIKELY(((frag_size + FRAGMENT_SIZE_MIN) <= from->diagnostics.capacity) &&
+                                  (gain <= (FRAGMENT_SIZE_MAX - to->diagnostics.capacity))))
+                {
+                    unbin(from, frag, frag_size);
+                    // The anchor keeps the source chain interlinking and size arithmetic intact and pins the
+                    // neighbors so that they can never merge across the donated memory. It is permanently owned
+                    // by the source allocator, much like the uncommitted-tail fragment of a lazy arena.
+                    fragSetUsed(frag, true);
+                    fragSetDonated(frag, true);
+#if O1HEAP_ENABLE_MARK_RELEASE
+                    fragSetSpeculative(frag, false);  // It shall never be reclaimed by o1heapRelease().
+#endif
+#if O1HEAP_ENABLE_RESERVE
+                    fragSetReserved(frag, false);
+#endif
+                    from->diagnostics.capacity -= frag_size;
+
+                    // Adopt the rest of the donated fragment as a new region hosting its own fragment chain,
+                    // terminated by the matching entry of the region table instead of the primary arena_end.
+                    char* const     region_start = ((char*) frag) + FRAGMENT_SIZE_MIN;
+                    Fragment* const adopted      = (Fragment*) (void*) region_start;
+                    fragSetNext(adopted, NULL);
+                    fragSetPrev(adopted, NULL);
+                    fragSetUsed(adopted, false);
+                    to->region_starts[to->region_count] = region_start;
+                    to->region_ends[to->region_count]   = region_start + gain;
+                    to->region_count++;
+                    to->diagnostics.capacity += gain;
+                    rebin(to, adopted, gain);
+                    out = gain;
+                }
+            }
+        }
+    }
+    return out;
+}
+#endif  // O1HEAP_ENABLE_DONATE
+
+void* o1heapAllocate(O1HeapInstance* const handle, const size_t amount)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    O1HEAP_ASSERT(handle->diagnostics.capacity <= FRAGMENT_SIZE_MAX);
+    void* out = NULL;
+
+    // If the amount approaches approx. SIZE_MAX/2, an undetected integer overflow may occur.
+    // To avoid that, we do not attempt allocation if the amount exceeds the hard limit.
+    // We perform multiple redundant checks to account for a possible unaccounted overflow.
+    if (O1HEAP_LIKELY((amount > 0U) && (amount <= (handle->diagnostics.capacity - O1HEAP_ALIGNMENT))))
+    {
+        // Add the header size and round the allocation size up to the sizing policy granularity:
+        // the next power of 2 by default, or the next fragment size multiple if sub-bins are enabled.
+        // See "Timing-Predictable Memory Allocation In Hard Real-Time Systems", Herter, page 27.
+        const size_t alloc_size = fragSizeForAmount(amount);
+        O1HEAP_ASSERT(alloc_size <= FRAGMENT_SIZE_MAX);
+        O1HEAP_ASSERT(alloc_size >= FRAGMENT_SIZE_MIN);
+        O1HEAP_ASSERT(alloc_size >= amount + O1HEAP_ALIGNMENT);
+        O1HEAP_ASSERT((alloc_size % FRAGMENT_SIZE_MIN) == 0U);
+
+#if O1HEAP_MAGAZINE_BINS > 0
+        // The magazine fast path: pop the most recently freed fragment of this class, if one is cached.
+        // The fragment is still marked used and still accounted as allocated, so no further bookkeeping is needed.
+        // Magazines are keyed by power-of-2 class; sub-bins are incompatible with them (enforced at compile time),
+        // so here alloc_size is guaranteed to be a power of 2 and log2Floor == log2Ceil.
+        const uint_fast8_t optimal_bin_index = log2Floor(alloc_size / FRAGMENT_SIZE_MIN);
+        O1HEAP_ASSERT(optimal_bin_index < NUM_BINS_MAX);
+        if (O1HEAP_LIKELY((optimal_bin_index < O1HEAP_MAGAZINE_BINS) &&
+                          (handle->magazine_heads[optimal_bin_index] != NULL)))
+        {
+            Fragment* const frag                     = handle->magazine_heads[optimal_bin_index];
+            handle->magazine_heads[optimal_bin_index] = frag->next_free;
+            O1HEAP_ASSERT(handle->magazine_sizes[optimal_bin_index] > 0U);
+            handle->magazine_sizes[optimal_bin_index]--;
+            O1HEAP_ASSERT(fragIsUsed(frag));
+            O1HEAP_ASSERT(fragGetSize(handle, frag) >= alloc_size);
+            out = ((char*) frag) + O1HEAP_ALIGNMENT;
+        }
+#endif
+
+        // Find the smallest free fragment we can use.
+        Fragment* const frag = (out == NULL) ? binFind(handle, alloc_size) : NULL;
+        if (O1HEAP_LIKELY(frag != NULL))
+        {
+            const size_t frag_size = fragGetSize(handle, frag);
+            O1HEAP_ASSERT(frag_size >= alloc_size);
+            O1HEAP_ASSERT((frag_size % FRAGMENT_SIZE_MIN) == 0U);
             O1HEAP_ASSERT(!fragIsUsed(frag));
             unbin(handle, frag, frag_size);
 
@@ -432,33 +1524,293 @@ void* o1heapAllocate(O1HeapInstance* const handle, const size_t amount)
                 interlink(frag, new_frag);
                 O1HEAP_ASSERT(leftover == fragGetSize(handle, new_frag));
                 rebin(handle, new_frag, leftover);
+#if O1HEAP_TELEMETRY
+                handle->split_count++;
+#endif
             }
 
             // Update the diagnostics.
+#if O1HEAP_DIAGNOSTICS
             O1HEAP_ASSERT((handle->diagnostics.allocated % FRAGMENT_SIZE_MIN) == 0U);
             handle->diagnostics.allocated += alloc_size;
             O1HEAP_ASSERT(handle->diagnostics.allocated <= handle->diagnostics.capacity);
             handle->diagnostics.peak_allocated =
                 larger(handle->diagnostics.peak_allocated, handle->diagnostics.allocated);
+#endif
 
             // Finalize the fragment we just allocated.
             O1HEAP_ASSERT(fragGetSize(handle, frag) >= amount + O1HEAP_ALIGNMENT);
             fragSetUsed(frag, true);
+#if O1HEAP_ENABLE_MARK_RELEASE
+            fragSetSpeculative(frag, handle->mark_active);
+#endif
+#if O1HEAP_ENABLE_RESERVE
+            fragSetReserved(frag, false);  // The flag bit may hold garbage until the first allocation clears it.
+#endif
+#if O1HEAP_ENABLE_DONATE
+            fragSetDonated(frag, false);  // Same: the flag bit may hold garbage until cleared here.
+#endif
 
             out = ((char*) frag) + O1HEAP_ALIGNMENT;
         }
     }
 
     // Update the diagnostics.
+#if O1HEAP_DIAGNOSTICS
     handle->diagnostics.peak_request_size = larger(handle->diagnostics.peak_request_size, amount);
     if (O1HEAP_LIKELY((out == NULL) && (amount > 0U)))
     {
         handle->diagnostics.oom_count++;
     }
+#endif
+
+    O1HEAP_TRACE_HOOK(handle, O1HEAP_TRACE_EVENT_ALLOCATE, out, amount);
+    return out;
+}
+
+#if O1HEAP_ENABLE_SCRUB
+
+void* o1heapAllocateZeroed(O1HeapInstance* const handle, const size_t amount)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    if (O1HEAP_LIKELY((amount > 0U) && (amount <= (handle->diagnostics.capacity - O1HEAP_ALIGNMENT))))
+    {
+        const size_t       alloc_size = roundUpToPowerOf2(amount + O1HEAP_ALIGNMENT);
+        const uint_fast8_t idx        = log2Floor(alloc_size / FRAGMENT_SIZE_MIN);
+        Fragment* const    frag       = handle->zeroed_bins[idx];
+        if (O1HEAP_LIKELY(frag != NULL))
+        {
+            // Pre-scrubbed fragment available: serve it in constant time. It is already marked used and
+            // accounted as allocated because it was obtained through the regular allocation path.
+            handle->zeroed_bins[idx] = frag->next_free;
+            frag->next_free          = NULL;  // This is payload memory; restore the zero overwritten by the link.
+            O1HEAP_ASSERT(fragIsUsed(frag));
+#if O1HEAP_DIAGNOSTICS
+            handle->diagnostics.peak_request_size = larger(handle->diagnostics.peak_request_size, amount);
+#endif
+            return ((char*) frag) + O1HEAP_ALIGNMENT;  // MISRA: Early return simplifies control flow.
+        }
+        handle->zeroed_demand_mask |= pow2(idx);  // Ask the scrubber to replenish this size class.
+    }
+    // No pre-scrubbed fragment: fall back to the variable-complexity explicit zeroing.
+    void* const out = o1heapAllocate(handle, amount);
+    if (O1HEAP_LIKELY(out != NULL))
+    {
+        (void) memset(out, 0, amount);
+    }
+    return out;
+}
+
+size_t o1heapScrubStep(O1HeapInstance* const handle, const size_t max_bytes)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    if (handle->scrub_frag == NULL)
+    {
+        // No zeroing in progress: pick up the smallest size class that recently missed, if any.
+        const size_t demand = handle->zeroed_demand_mask;
+        if (O1HEAP_LIKELY(demand == 0U))
+        {
+            return 0U;  // MISRA: Early return simplifies control flow.
+        }
+        const uint_fast8_t idx     = log2Floor(demand & ~(demand - 1U));
+        const size_t       payload = (pow2(idx) * FRAGMENT_SIZE_MIN) - O1HEAP_ALIGNMENT;
+        handle->zeroed_demand_mask &= ~pow2(idx);  // Clear even on failure so OOM does not cause busy-spinning.
+        void* const ptr = o1heapAllocate(handle, payload);
+        if (O1HEAP_UNLIKELY(ptr == NULL))
+        {
+            return 0U;  // MISRA: Early return simplifies control flow.
+        }
+        handle->scrub_frag = (Fragment*) (void*) (((char*) ptr) - O1HEAP_ALIGNMENT);
+        handle->scrub_done = 0U;
+    }
+
+    // Zero at most max_bytes of the pending fragment's payload; park it in the pool when complete.
+    Fragment* const frag         = handle->scrub_frag;
+    const size_t    payload_size = fragGetSize(handle, frag) - O1HEAP_ALIGNMENT;
+    O1HEAP_ASSERT(handle->scrub_done < payload_size);
+    const size_t remaining = payload_size - handle->scrub_done;
+    const size_t chunk     = (remaining < max_bytes) ? remaining : max_bytes;
+    (void) memset((((char*) frag) + O1HEAP_ALIGNMENT) + handle->scrub_done, 0, chunk);
+    handle->scrub_done += chunk;
+    if (handle->scrub_done >= payload_size)
+    {
+        const uint_fast8_t idx = log2Floor(fragGetSize(handle, frag) / FRAGMENT_SIZE_MIN);
+        O1HEAP_ASSERT(idx < NUM_BINS_MAX);
+        frag->next_free         = handle->zeroed_bins[idx];  // Overwrites the first payload word; restored on pop.
+        handle->zeroed_bins[idx] = frag;
+        handle->scrub_frag       = NULL;
+        handle->scrub_done       = 0U;
+    }
+    return chunk;
+}
+
+#endif  // O1HEAP_ENABLE_SCRUB
+
+size_t o1heapAllocateBatch(O1HeapInstance* const handle,
+                           const size_t          amount,
+                           const size_t          count,
+                           void** const          out_pointers)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    O1HEAP_ASSERT((out_pointers != NULL) || (count == 0U));
+    size_t n = 0U;
+    if (O1HEAP_LIKELY((amount > 0U) && (amount <= (handle->diagnostics.capacity - O1HEAP_ALIGNMENT))))
+    {
+        // The size class is computed once for the whole batch; see o1heapAllocate() for the details.
+        const size_t alloc_size = fragSizeForAmount(amount);
+        O1HEAP_ASSERT((alloc_size >= FRAGMENT_SIZE_MIN) && (alloc_size <= FRAGMENT_SIZE_MAX));
+
+        while (n < count)
+        {
+            Fragment* frag = binFind(handle, alloc_size);
+            if (O1HEAP_UNLIKELY(frag == NULL))
+            {
+                break;  // Out of memory; the fragments allocated so far remain valid.
+            }
+            size_t frag_size = fragGetSize(handle, frag);
+            O1HEAP_ASSERT(frag_size >= alloc_size);
+            unbin(handle, frag, frag_size);
+
+            // Carve consecutive fragments off the front of the free fragment in a single pass:
+            // one unbin, one interlink per carved fragment, and at most one rebin of the leftover.
+            while ((n < count) && (frag != NULL))
+            {
+                const size_t leftover = frag_size - alloc_size;
+                O1HEAP_ASSERT((leftover % FRAGMENT_SIZE_MIN) == 0U);
+                if (O1HEAP_LIKELY(leftover >= FRAGMENT_SIZE_MIN))
+                {
+                    Fragment* const new_frag = (Fragment*) (void*) (((char*) frag) + alloc_size);
+                    fragSetUsed(new_frag, false);
+                    interlink(new_frag, fragGetNext(frag));
+                    interlink(frag, new_frag);
+                    fragSetUsed(frag, true);
+#if O1HEAP_ENABLE_MARK_RELEASE
+                    fragSetSpeculative(frag, handle->mark_active);
+#endif
+#if O1HEAP_ENABLE_RESERVE
+                    fragSetReserved(frag, false);
+#endif
+#if O1HEAP_ENABLE_DONATE
+                    fragSetDonated(frag, false);
+#endif
+#if O1HEAP_TELEMETRY
+                    handle->split_count++;
+#endif
+#if O1HEAP_DIAGNOSTICS
+                    handle->diagnostics.allocated += alloc_size;
+#endif
+                    out_pointers[n] = ((char*) frag) + O1HEAP_ALIGNMENT;
+                    O1HEAP_TRACE_HOOK(handle, O1HEAP_TRACE_EVENT_ALLOCATE, out_pointers[n], amount);
+                    n++;
+                    frag      = new_frag;
+                    frag_size = leftover;
+                    if (O1HEAP_UNLIKELY(frag_size < alloc_size))
+                    {
+                        rebin(handle, frag, frag_size);  // Too small to carve from; try the next bin.
+                        frag = NULL;
+                    }
+                }
+                else
+                {
+                    // The leftover cannot form a fragment of its own, so the entire remainder is served.
+                    fragSetUsed(frag, true);
+#if O1HEAP_ENABLE_MARK_RELEASE
+                    fragSetSpeculative(frag, handle->mark_active);
+#endif
+#if O1HEAP_ENABLE_RESERVE
+                    fragSetReserved(frag, false);
+#endif
+#if O1HEAP_ENABLE_DONATE
+                    fragSetDonated(frag, false);
+#endif
+#if O1HEAP_DIAGNOSTICS
+                    handle->diagnostics.allocated += frag_size;
+#endif
+                    out_pointers[n] = ((char*) frag) + O1HEAP_ALIGNMENT;
+                    O1HEAP_TRACE_HOOK(handle, O1HEAP_TRACE_EVENT_ALLOCATE, out_pointers[n], amount);
+                    n++;
+                    frag = NULL;
+                }
+            }
+            if (frag != NULL)  // The batch is complete but a usable leftover remains.
+            {
+                rebin(handle, frag, frag_size);
+            }
+        }
+#if O1HEAP_DIAGNOSTICS
+        O1HEAP_ASSERT(handle->diagnostics.allocated <= handle->diagnostics.capacity);
+        handle->diagnostics.peak_allocated = larger(handle->diagnostics.peak_allocated, handle->diagnostics.allocated);
+#endif
+    }
+
+    // Update the diagnostics. An empty batch is a no-op that shall leave no trace.
+#if O1HEAP_DIAGNOSTICS
+    if (O1HEAP_LIKELY(count > 0U))
+    {
+        handle->diagnostics.peak_request_size = larger(handle->diagnostics.peak_request_size, amount);
+        if (O1HEAP_UNLIKELY((n < count) && (amount > 0U)))
+        {
+            handle->diagnostics.oom_count++;
+        }
+    }
+#endif
+    return n;
+}
 
+void o1heapFreeBatch(O1HeapInstance* const handle, void* const* const pointers, const size_t count)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    O1HEAP_ASSERT((pointers != NULL) || (count == 0U));
+    // Adjacent fragments freed in the same batch coalesce through the regular merge logic irrespective of the
+    // order in which they appear, so no sorting pass is needed; the per-element cost is constant.
+    for (size_t i = 0U; i < count; i++)
+    {
+        o1heapFree(handle, pointers[i]);
+    }
+}
+
+void* o1heapAllocateAligned(O1HeapInstance* const handle, const size_t amount, const size_t alignment)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    void* out = NULL;
+    // The alignment shall be a power of 2 not smaller than O1HEAP_ALIGNMENT.
+    const bool alignment_valid = (alignment >= O1HEAP_ALIGNMENT) && ((alignment & (alignment - 1U)) == 0U);
+    if (O1HEAP_LIKELY(alignment_valid && (amount > 0U) && (amount <= (SIZE_MAX - alignment))))
+    {
+        // Over-allocate by the alignment so that an aligned payload with room for the back-reference always fits.
+        // Carving the fragment so that the payload itself lands aligned is not possible in the general case:
+        // fragment offsets are only guaranteed to be multiples of O1HEAP_ALIGNMENT, and a front padding fragment
+        // would have to be a multiple of FRAGMENT_SIZE_MIN, which the arena parity does not always permit.
+        char* const raw = (char*) o1heapAllocate(handle, amount + alignment);
+        if (O1HEAP_LIKELY(raw != NULL))
+        {
+            // The aligned pointer is advanced past the back-reference slot; it never equals the raw pointer.
+            const size_t addr = (((size_t) raw) + sizeof(void*) + alignment - 1U) & ~(alignment - 1U);
+            O1HEAP_ASSERT((addr - ((size_t) raw)) >= sizeof(void*));
+            O1HEAP_ASSERT((addr + amount) <= (((size_t) raw) + amount + alignment));
+            void** const slot = (void**) (void*) (addr - sizeof(void*));
+            *slot             = raw;
+            out               = (void*) (void**) (void*) addr;
+        }
+    }
     return out;
 }
 
+void o1heapFreeAligned(O1HeapInstance* const handle, void* const pointer)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    if (O1HEAP_LIKELY(pointer != NULL))  // NULL pointer is a no-op.
+    {
+        O1HEAP_ASSERT((((size_t) pointer) % O1HEAP_ALIGNMENT) == 0U);
+        void** const slot = (void**) (void*) (((size_t) pointer) - sizeof(void*));
+        void* const  raw  = *slot;
+        // The back-reference shall point backward by no more than the largest supported alignment.
+        O1HEAP_ASSERT(raw != NULL);
+        O1HEAP_ASSERT(((size_t) raw) < ((size_t) pointer));
+        o1heapFree(handle, raw);
+    }
+}
+
 void o1heapFree(O1HeapInstance* const handle, void* const pointer)
 {
     O1HEAP_ASSERT(handle != NULL);
@@ -467,11 +1819,26 @@ void o1heapFree(O1HeapInstance* const handle, void* const pointer)
     {
         Fragment* const frag = (Fragment*) (void*) (((char*) pointer) - O1HEAP_ALIGNMENT);
 
+#if O1HEAP_ENABLE_HARDENING
+        // Reject the pointer gracefully instead of corrupting the heap state; see fragValidate().
+        // This must precede the assertion checks below because they would abort on an invalid pointer.
+        if (O1HEAP_UNLIKELY(!fragValidate(handle, frag)))
+        {
+            handle->diagnostics.bad_free_count++;
+            return;  // MISRA: Early return simplifies control flow.
+        }
+#endif
+
         // Check for heap corruption in debug builds.
         O1HEAP_ASSERT(((size_t) frag) % sizeof(Fragment*) == 0U);
+#if O1HEAP_ENABLE_DONATE
+        // An adopted region may reside at an arbitrary address, so only the containment predicate applies.
+        O1HEAP_ASSERT(addressIsFragment(handle, (size_t) frag));
+#else
         O1HEAP_ASSERT(((size_t) frag) >= (((size_t) handle) + INSTANCE_SIZE_PADDED));
         O1HEAP_ASSERT(((size_t) frag) <=
                       (((size_t) handle) + INSTANCE_SIZE_PADDED + handle->diagnostics.capacity - FRAGMENT_SIZE_MIN));
+#endif
         O1HEAP_ASSERT(fragIsUsed(frag));  // Catch double-free
         O1HEAP_ASSERT(((size_t) fragGetNext(frag)) % sizeof(Fragment*) == 0U);
         O1HEAP_ASSERT(((size_t) fragGetPrev(frag)) % sizeof(Fragment*) == 0U);
@@ -480,48 +1847,170 @@ void o1heapFree(O1HeapInstance* const handle, void* const pointer)
         O1HEAP_ASSERT(frag_size <= handle->diagnostics.capacity);
         O1HEAP_ASSERT((frag_size % FRAGMENT_SIZE_MIN) == 0U);
 
-        // Even if we're going to drop the fragment later, mark it free anyway to prevent double-free.
-        fragSetUsed(frag, false);
+        O1HEAP_TRACE_HOOK(handle, O1HEAP_TRACE_EVENT_FREE, pointer, frag_size - O1HEAP_ALIGNMENT);
 
-        // Update the diagnostics. It must be done before merging because it invalidates the fragment size information.
-        O1HEAP_ASSERT(handle->diagnostics.allocated >= frag_size);  // Heap corruption check.
-        handle->diagnostics.allocated -= frag_size;
+#if O1HEAP_ENABLE_DEFRAG
+        relocRemove(handle, pointer);  // The object ceases to exist; its relocation registration must not outlive it.
+#endif
 
-        // Merge with siblings and insert the returned fragment into the appropriate bin and update metadata.
-        Fragment* const prev       = fragGetPrev(frag);
-        Fragment* const next       = fragGetNext(frag);
-        const bool      join_left  = (prev != NULL) && (!fragIsUsed(prev));
-        const bool      join_right = (next != NULL) && (!fragIsUsed(next));
-        if (join_left && join_right)  // [ prev ][ this ][ next ] => [ ------- prev ------- ]
+#if O1HEAP_ENABLE_RESERVE
+        // A reserve-tagged fragment returns to the reserve rather than to the general bins. It stays marked used
+        // so its neighbors cannot coalesce with it, keeping the pre-carved capacity available indefinitely.
+        if (O1HEAP_UNLIKELY(fragIsReserved(frag)))
         {
-            const size_t prev_size = fragGetSize(handle, prev);
-            const size_t next_size = fragGetSize(handle, next);
-            unbin(handle, prev, prev_size);
-            unbin(handle, next, next_size);
-            interlink(prev, fragGetNext(next));
-            rebin(handle, prev, prev_size + frag_size + next_size);
+#if O1HEAP_ENABLE_HARDENING
+            // A reserve-parked fragment stays marked used, so a double-free of it would pass fragValidate();
+            // scan the reserve explicitly. The cost is bounded by the reserve depth chosen by the application.
+            for (const Fragment* m = handle->reserve_head; m != NULL; m = m->next_free)
+            {
+                if (O1HEAP_UNLIKELY(m == frag))
+                {
+                    handle->diagnostics.bad_free_count++;
+                    return;  // MISRA: Early return simplifies control flow.
+                }
+            }
+#endif
+            frag->next_free      = handle->reserve_head;
+            handle->reserve_head = frag;
+            handle->reserve_count++;
+            return;  // MISRA: Early return simplifies control flow.
         }
-        else if (join_left)  // [ prev ][ this ][ next ] => [ --- prev --- ][ next ]
+#endif
+
+#if O1HEAP_MAGAZINE_BINS > 0
+        // Small fragments are parked in their magazine instead of being merged back into the bins.
+        // The fragment stays marked used so its neighbors cannot coalesce with it while it is cached.
+        const uint_fast8_t mag_idx = log2Floor(frag_size / FRAGMENT_SIZE_MIN);
+        if (O1HEAP_LIKELY(mag_idx < O1HEAP_MAGAZINE_BINS))
         {
-            const size_t prev_size = fragGetSize(handle, prev);
-            unbin(handle, prev, prev_size);
-            interlink(prev, next);
-            rebin(handle, prev, prev_size + frag_size);
+#if O1HEAP_ENABLE_HARDENING
+            // A magazine-parked fragment stays marked used, so a double-free of it would pass fragValidate();
+            // scan the magazine explicitly (bounded by O1HEAP_MAGAZINE_DEPTH, hence still constant time).
+            for (const Fragment* m = handle->magazine_heads[mag_idx]; m != NULL; m = m->next_free)
+            {
+                if (O1HEAP_UNLIKELY(m == frag))
+                {
+                    handle->diagnostics.bad_free_count++;
+                    return;  // MISRA: Early return simplifies control flow.
+                }
+            }
+#endif
+            if (O1HEAP_UNLIKELY(handle->magazine_sizes[mag_idx] >= O1HEAP_MAGAZINE_DEPTH))
+            {
+                magazineFlush(handle, mag_idx);
+            }
+            frag->next_free                 = handle->magazine_heads[mag_idx];
+            handle->magazine_heads[mag_idx] = frag;
+            handle->magazine_sizes[mag_idx]++;
+            return;  // MISRA: Early return simplifies control flow.
         }
-        else if (join_right)  // [ prev ][ this ][ next ] => [ prev ][ --- this --- ]
+#endif
+        freeFragment(handle, frag, frag_size);
+    }
+}
+
+#if O1HEAP_ENABLE_DEFERRED_FREE
+
+void o1heapFreeDeferred(O1HeapInstance* const handle, void* const pointer)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    if (O1HEAP_LIKELY(pointer != NULL))  // NULL pointer is a no-op, same as o1heapFree().
+    {
+        Fragment* const frag = (Fragment*) (void*) (((char*) pointer) - O1HEAP_ALIGNMENT);
+
+        // Check for heap corruption in debug builds. The fragment state itself is not modified here --
+        // the full free protocol is executed later by the owning thread in o1heapDrainDeferred().
+        O1HEAP_ASSERT(((size_t) frag) % sizeof(Fragment*) == 0U);
+#if O1HEAP_ENABLE_DONATE
+        O1HEAP_ASSERT(addressIsFragment(handle, (size_t) frag));  // An adopted region may be at any address.
+#else
+        O1HEAP_ASSERT(((size_t) frag) >= (((size_t) handle) + INSTANCE_SIZE_PADDED));
+#endif
+        O1HEAP_ASSERT(fragIsUsed(frag));  // Catch double-free
+
+        // Push the fragment onto the lock-free MPSC stack. The fragment is still marked used, so the payload
+        // area holding next_free is dead from the application's perspective and safe to repurpose as the link.
+        Fragment* head = handle->deferred_free_head;
+        do
         {
-            const size_t next_size = fragGetSize(handle, next);
-            unbin(handle, next, next_size);
-            interlink(frag, fragGetNext(next));
-            rebin(handle, frag, frag_size + next_size);
-        }
-        else
+            frag->next_free = head;
+        } while (!O1HEAP_ATOMIC_CAS_PTR(&handle->deferred_free_head, &head, frag));
+    }
+}
+
+size_t o1heapDrainDeferred(O1HeapInstance* const handle)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    size_t count = 0U;
+    // Detach the entire pending stack in one atomic exchange; concurrent producers start a new stack.
+    Fragment* frag = O1HEAP_ATOMIC_EXCHANGE_PTR(&handle->deferred_free_head, NULL);
+    while (frag != NULL)
+    {
+        // The link must be sampled before the free because coalescing overwrites next_free.
+        Fragment* const next = frag->next_free;
+        o1heapFree(handle, ((char*) frag) + O1HEAP_ALIGNMENT);
+        frag = next;
+        count++;
+    }
+    return count;
+}
+
+#endif  // O1HEAP_ENABLE_DEFERRED_FREE
+
+#if O1HEAP_ENABLE_RESERVE
+
+size_t o1heapReserve(O1HeapInstance* const handle, const size_t amount, const size_t count)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    size_t n = 0U;
+    while (n < count)
+    {
+        // Carve through the regular allocation path so that splitting, diagnostics, and telemetry behave as
+        // for any other allocation. Memory parked in the reserve is reported as allocated.
+        void* const pointer = o1heapAllocate(handle, amount);
+        if (O1HEAP_UNLIKELY(pointer == NULL))
         {
-            rebin(handle, frag, frag_size);
+            break;  // Out of memory; the fragments reserved so far are retained.
         }
+        Fragment* const frag = (Fragment*) (void*) (((char*) pointer) - O1HEAP_ALIGNMENT);
+        O1HEAP_ASSERT(fragIsUsed(frag));
+        fragSetReserved(frag, true);
+#if O1HEAP_ENABLE_MARK_RELEASE
+        fragSetSpeculative(frag, false);  // The reservation is permanent; it shall survive a rollback.
+#endif
+        frag->next_free      = handle->reserve_head;
+        handle->reserve_head = frag;
+        handle->reserve_count++;
+        n++;
     }
+    return n;
+}
+
+void* o1heapAllocateReserved(O1HeapInstance* const handle)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    void*           out  = NULL;
+    Fragment* const frag = handle->reserve_head;
+    if (O1HEAP_LIKELY(frag != NULL))
+    {
+        O1HEAP_ASSERT(handle->reserve_count > 0U);
+        O1HEAP_ASSERT(fragIsUsed(frag) && fragIsReserved(frag));
+        handle->reserve_head = frag->next_free;
+        handle->reserve_count--;
+        // The fragment keeps its reserved tag so that o1heapFree() returns it to the reserve, not to the bins.
+        out = ((char*) frag) + O1HEAP_ALIGNMENT;
+    }
+    return out;
+}
+
+size_t o1heapGetReservedCount(const O1HeapInstance* const handle)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    return handle->reserve_count;
 }
 
+#endif  // O1HEAP_ENABLE_RESERVE
+
 void* o1heapReallocate(O1HeapInstance* const handle, void* const pointer, const size_t new_amount)
 {
     O1HEAP_ASSERT(handle != NULL);
@@ -541,21 +2030,33 @@ void* o1heapReallocate(O1HeapInstance* const handle, void* const pointer, const
     }
 
     // SPECIAL CASE: Prevent size overflow like in o1heapAllocate().
+#if O1HEAP_DIAGNOSTICS
     handle->diagnostics.peak_request_size = larger(handle->diagnostics.peak_request_size, new_amount);
+#endif
     if (O1HEAP_UNLIKELY(new_amount > (handle->diagnostics.capacity - O1HEAP_ALIGNMENT)))
     {
+#if O1HEAP_DIAGNOSTICS
         handle->diagnostics.oom_count++;
+#endif
         return NULL;  // MISRA: Early return simplifies control flow.
     }
 
     // NORMAL REALLOC BEHAVIORS. The edge cases have been handled above.
+    // The delegation cases are reported by the delegated calls as plain allocate/free events.
+    O1HEAP_TRACE_HOOK(handle, O1HEAP_TRACE_EVENT_REALLOCATE, pointer, new_amount);
     Fragment* const frag          = (Fragment*) (void*) (((char*) pointer) - O1HEAP_ALIGNMENT);
     const size_t    frag_size     = fragGetSize(handle, frag);
     const size_t    old_amount    = frag_size - O1HEAP_ALIGNMENT;
-    const size_t    new_frag_size = roundUpToPowerOf2(new_amount + O1HEAP_ALIGNMENT);
+    const size_t    new_frag_size = fragSizeForAmount(new_amount);
+    // NB: new_frag_size may exceed the capacity for amounts just below it due to the power-of-2 rounding;
+    // such requests fall through the in-place branches below and are reported as OOM by the delegated allocation.
     O1HEAP_ASSERT((new_frag_size <= FRAGMENT_SIZE_MAX) && (new_frag_size >= FRAGMENT_SIZE_MIN));
-    O1HEAP_ASSERT(new_frag_size <= handle->diagnostics.capacity);
     O1HEAP_ASSERT(fragIsUsed(frag));  // Catch use-after-free.
+#if O1HEAP_ENABLE_RESERVE
+    // Reallocation may change the fragment size, which would break the availability guarantee if the fragment
+    // later returned to the reserve. Demote it to a regular allocation instead; see o1heapReserve().
+    fragSetReserved(frag, false);
+#endif
 
     Fragment*    prev      = fragGetPrev(frag);
     Fragment*    next      = fragGetNext(frag);
@@ -571,17 +2072,25 @@ void* o1heapReallocate(O1HeapInstance* const handle, void* const pointer, const
         O1HEAP_ASSERT((leftover % FRAGMENT_SIZE_MIN) == 0U);
         if (O1HEAP_LIKELY(leftover >= FRAGMENT_SIZE_MIN))
         {
+#if O1HEAP_DIAGNOSTICS
             O1HEAP_ASSERT(handle->diagnostics.allocated >= leftover);
             handle->diagnostics.allocated -= leftover;
+#endif
             Fragment* const new_frag = (Fragment*) (void*) (((char*) frag) + new_frag_size);
             fragSetUsed(new_frag, false);
             interlink(frag, new_frag);
+#if O1HEAP_TELEMETRY
+            handle->split_count++;
+#endif
             if (O1HEAP_LIKELY(next_free))  // [ frag ][ new ][ next ] => [ frag ][ --- new --- ]
             {
                 unbin(handle, next, next_size);
                 interlink(new_frag, fragGetNext(next));
                 O1HEAP_ASSERT(fragGetSize(handle, new_frag) == (leftover + next_size));
                 rebin(handle, new_frag, leftover + next_size);
+#if O1HEAP_TELEMETRY
+                handle->merge_count++;
+#endif
             }
             else  // [ frag ][ new ][ next ]
             {
@@ -608,14 +2117,27 @@ void* o1heapReallocate(O1HeapInstance* const handle, void* const pointer, const
             interlink(new_frag, fragGetNext(next));
             interlink(frag, new_frag);
             rebin(handle, new_frag, leftover);
+#if O1HEAP_TELEMETRY
+            handle->split_count++;  // The next fragment was split; its front part was merged into this one.
+            handle->merge_count++;
+#endif
+#if O1HEAP_DIAGNOSTICS
             handle->diagnostics.allocated += new_frag_size - frag_size;
+#endif
         }
         else  // [ frag ][ --- next --- ] => [ --- frag --- ]
         {
             interlink(frag, fragGetNext(next));
+#if O1HEAP_TELEMETRY
+            handle->merge_count++;
+#endif
+#if O1HEAP_DIAGNOSTICS
             handle->diagnostics.allocated += next_size;
+#endif
         }
+#if O1HEAP_DIAGNOSTICS
         handle->diagnostics.peak_allocated = larger(handle->diagnostics.peak_allocated, handle->diagnostics.allocated);
+#endif
         return pointer;  // MISRA: Early return simplifies control flow.
     }
 
@@ -631,8 +2153,20 @@ void* o1heapReallocate(O1HeapInstance* const handle, void* const pointer, const
             unbin(handle, next, next_size);
         }
         void* const out = ((char*) prev) + O1HEAP_ALIGNMENT;  // Move all the way to the back before fragments updated.
+#if O1HEAP_ENABLE_MARK_RELEASE
+        const bool speculative = fragIsSpeculative(frag);  // Sample before the move invalidates the old header.
+#endif
         (void) memmove(out, pointer, old_amount);  // ATTENTION: Invalidates the old frag due to potential overwrite.
         fragSetUsed(prev, true);
+#if O1HEAP_ENABLE_MARK_RELEASE
+        fragSetSpeculative(prev, speculative);  // The object retains its identity when moved in place.
+#endif
+#if O1HEAP_ENABLE_RESERVE
+        fragSetReserved(prev, false);  // The header is written over arbitrary data; reallocation demotes anyway.
+#endif
+#if O1HEAP_ENABLE_DONATE
+        fragSetDonated(prev, false);  // Same: the garbage in the flag bit shall not survive.
+#endif
         const size_t leftover = (prev_size + frag_size + next_size) - new_frag_size;
         O1HEAP_ASSERT((leftover % FRAGMENT_SIZE_MIN) == 0U);
         if (O1HEAP_LIKELY(leftover >= FRAGMENT_SIZE_MIN))
@@ -642,14 +2176,30 @@ void* o1heapReallocate(O1HeapInstance* const handle, void* const pointer, const
             interlink(new_frag, next_free ? fragGetNext(next) : next);
             interlink(prev, new_frag);  // NOLINT(readability-suspicious-call-argument)
             rebin(handle, new_frag, leftover);
+#if O1HEAP_TELEMETRY
+            handle->split_count++;
+            handle->merge_count += next_free ? 2U : 1U;
+#endif
+#if O1HEAP_DIAGNOSTICS
             handle->diagnostics.allocated += new_frag_size - frag_size;
+#endif
         }
         else
         {
             interlink(prev, next_free ? fragGetNext(next) : next);
+#if O1HEAP_TELEMETRY
+            handle->merge_count += next_free ? 2U : 1U;
+#endif
+#if O1HEAP_DIAGNOSTICS
             handle->diagnostics.allocated += prev_size + next_size;
+#endif
         }
+#if O1HEAP_DIAGNOSTICS
         handle->diagnostics.peak_allocated = larger(handle->diagnostics.peak_allocated, handle->diagnostics.allocated);
+#endif
+#if O1HEAP_ENABLE_DEFRAG
+        relocUpdate(handle, pointer, out);  // The registration follows the moved object.
+#endif
         return out;  // MISRA: Early return simplifies control flow.
     }
 
@@ -659,17 +2209,537 @@ void* o1heapReallocate(O1HeapInstance* const handle, void* const pointer, const
     if (out != NULL)
     {
         (void) memcpy(out, pointer, old_amount);
+#if O1HEAP_ENABLE_DEFRAG
+        relocUpdate(handle, pointer, out);  // Must precede the free so the registration is not dropped with it.
+#endif
+        o1heapFree(handle, pointer);
+    }
+    return out;
+}
+
+bool o1heapTryExpand(O1HeapInstance* const handle, void* const pointer, const size_t new_amount)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    O1HEAP_ASSERT(handle->diagnostics.capacity <= FRAGMENT_SIZE_MAX);
+    O1HEAP_ASSERT(pointer != NULL);
+
+    // Prevent size overflow like in o1heapAllocate(). The failure is an expected outcome of this probe,
+    // so unlike o1heapReallocate() it does not count against the OOM statistics.
+    if (O1HEAP_UNLIKELY((new_amount == 0U) || (new_amount > (handle->diagnostics.capacity - O1HEAP_ALIGNMENT))))
+    {
+        return false;  // MISRA: Early return simplifies control flow.
+    }
+
+    Fragment* const frag          = (Fragment*) (void*) (((char*) pointer) - O1HEAP_ALIGNMENT);
+    const size_t    frag_size     = fragGetSize(handle, frag);
+    const size_t    new_frag_size = fragSizeForAmount(new_amount);
+    O1HEAP_ASSERT((new_frag_size <= FRAGMENT_SIZE_MAX) && (new_frag_size >= FRAGMENT_SIZE_MIN));
+    O1HEAP_ASSERT(fragIsUsed(frag));  // Catch use-after-free.
+
+    // ALREADY LARGE ENOUGH: the rounded-up capacity covers the request; the fragment is never shrunk.
+    if (O1HEAP_LIKELY(new_frag_size <= frag_size))
+    {
+        return true;  // MISRA: Early return simplifies control flow.
+    }
+
+    // EXPAND FORWARD: this is the only growth case supported here; see o1heapReallocate() for the moving cases.
+    Fragment* const next      = fragGetNext(frag);
+    const bool      next_free = (next != NULL) && (!fragIsUsed(next));
+    const size_t    next_size = next_free ? fragGetSize(handle, next) : 0U;
+    if (next_free && ((frag_size + next_size) >= new_frag_size))
+    {
+        unbin(handle, next, next_size);
+#if O1HEAP_ENABLE_RESERVE
+        // The fragment size changes, which would break the availability guarantee if it later returned to the
+        // reserve. Demote it to a regular allocation instead; see o1heapReserve().
+        fragSetReserved(frag, false);
+#endif
+        const size_t leftover = (frag_size + next_size) - new_frag_size;
+        O1HEAP_ASSERT((leftover % FRAGMENT_SIZE_MIN) == 0U);
+        if (O1HEAP_LIKELY(leftover >= FRAGMENT_SIZE_MIN))  // [ frag ][ --- next --- ] => [ --- frag --- ][ next ]
+        {
+            Fragment* const new_frag = (Fragment*) (void*) (((char*) frag) + new_frag_size);
+            fragSetUsed(new_frag, false);
+            interlink(new_frag, fragGetNext(next));
+            interlink(frag, new_frag);
+            rebin(handle, new_frag, leftover);
+#if O1HEAP_TELEMETRY
+            handle->split_count++;  // The next fragment was split; its front part was merged into this one.
+            handle->merge_count++;
+#endif
+#if O1HEAP_DIAGNOSTICS
+            handle->diagnostics.allocated += new_frag_size - frag_size;
+#endif
+        }
+        else  // [ frag ][ --- next --- ] => [ --- frag --- ]
+        {
+            interlink(frag, fragGetNext(next));
+#if O1HEAP_TELEMETRY
+            handle->merge_count++;
+#endif
+#if O1HEAP_DIAGNOSTICS
+            handle->diagnostics.allocated += next_size;
+#endif
+        }
+#if O1HEAP_DIAGNOSTICS
+        handle->diagnostics.peak_allocated = larger(handle->diagnostics.peak_allocated, handle->diagnostics.allocated);
+#endif
+        return true;  // MISRA: Early return simplifies control flow.
+    }
+    return false;
+}
+
+void* o1heapReallocateHinted(O1HeapInstance* const handle,
+                             void* const           pointer,
+                             const size_t          new_amount,
+                             const size_t          expected_final)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    const size_t hinted = larger(new_amount, expected_final);
+
+    // SPECIAL CASE: Allocation delegation, sized for the expected final amount straight away.
+    if (O1HEAP_UNLIKELY(pointer == NULL))
+    {
+        return o1heapAllocate(handle, hinted);  // MISRA: Early return simplifies control flow.
+    }
+
+    // SPECIAL CASE: Free delegation, same as o1heapReallocate().
+    if (O1HEAP_UNLIKELY(new_amount == 0U))
+    {
+        o1heapFree(handle, pointer);
+        return NULL;  // MISRA: Early return simplifies control flow.
+    }
+
+    // IN PLACE: the current fragment already covers the request or can be grown over its free successor.
+    // The fragment is intentionally never shrunk: the slack is the headroom that avoids the next move.
+    if (O1HEAP_LIKELY(o1heapTryExpand(handle, pointer, new_amount)))
+    {
+        return pointer;  // MISRA: Early return simplifies control flow.
+    }
+
+    // MOVE: a copy is unavoidable, so pay for it once by sizing the destination for the expected final amount;
+    // the subsequent growth steps up to that amount then hit the constant-time in-place branch above.
+    void* const out = o1heapAllocate(handle, hinted);
+    if (O1HEAP_LIKELY(out != NULL))
+    {
+        // The expand probe above failed, so the request is strictly larger than the old capacity;
+        // hence the entire old payload is copied, same as the final-resort branch of o1heapReallocate().
+        const size_t old_amount = fragGetSize(handle, (Fragment*) (void*) (((char*) pointer) - O1HEAP_ALIGNMENT)) -
+                                  O1HEAP_ALIGNMENT;
+        (void) memcpy(out, pointer, old_amount);
+#if O1HEAP_ENABLE_DEFRAG
+        relocUpdate(handle, pointer, out);  // Must precede the free so the registration is not dropped with it.
+#endif
         o1heapFree(handle, pointer);
+        return out;  // MISRA: Early return simplifies control flow.
+    }
+
+    // FALLBACK: the hinted fragment does not fit, but a plain reallocation may still succeed by merging with
+    // free neighbors (the expand-backward case), so the hint is dropped rather than failing the request.
+    return o1heapReallocate(handle, pointer, new_amount);
+}
+
+size_t o1heapGetAllocatedSize(const O1HeapInstance* const handle, const void* const pointer)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    if (O1HEAP_UNLIKELY(pointer == NULL))
+    {
+        return 0U;  // MISRA: Early return simplifies control flow.
+    }
+    const Fragment* const frag = (const Fragment*) (const void*) (((const char*) pointer) - O1HEAP_ALIGNMENT);
+    O1HEAP_ASSERT(fragIsUsed(frag));  // Catch use-after-free.
+    return fragGetSize(handle, frag) - O1HEAP_ALIGNMENT;
+}
+
+size_t o1heapIterate(O1HeapInstance* const handle,
+                     const O1HeapFragmentCallback callback,
+                     void* const                  context,
+                     const size_t                 max_fragments)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    if (O1HEAP_UNLIKELY(max_fragments == 0U))
+    {
+        handle->iterate_cursor = NULL;  // Abandon the walk in progress, if any.
+        return 0U;                      // MISRA: Early return simplifies control flow.
+    }
+    O1HEAP_ASSERT(callback != NULL);
+    // Resume from the saved cursor, or start over from the arena base if no walk is in progress.
+    Fragment* frag = (handle->iterate_cursor != NULL)
+                         ? handle->iterate_cursor
+                         : (Fragment*) (void*) (((char*) handle) + INSTANCE_SIZE_PADDED);
+    size_t count = 0U;
+    bool   go_on = true;
+    while (go_on && (frag != NULL) && (count < max_fragments))
+    {
+        // The uncommitted-tail fragment of a lazily initialized arena belongs to the allocator, not to the
+        // application, so it is not reported; it is always the last fragment of its chain, so it is skipped.
+        // The anchor of a donated-away region is likewise allocator-owned and must not be reported: its nominal
+        // extent spans memory that belongs to the recipient instance, so writing into it would corrupt that heap.
+        if (O1HEAP_LIKELY((frag != handle->uncommitted) && ((frag->header.prev_used & FRAGMENT_FLAG_DONATED) == 0U)))
+        {
+            count++;
+            go_on = callback(context,
+                             ((char*) frag) + O1HEAP_ALIGNMENT,
+                             fragGetSize(handle, frag) - O1HEAP_ALIGNMENT,
+                             fragIsUsed(frag));
+        }
+        Fragment* next = fragGetNext(frag);
+#if O1HEAP_ENABLE_DONATE
+        if (next == NULL)
+        {
+            next = chainSuccessor(handle, frag);  // Continue into the adopted region chains, if any.
+        }
+#endif
+        frag = next;
+    }
+    // The cursor is retained only if the walk was truncated by the cap; completion or abort resets it.
+    handle->iterate_cursor = go_on ? frag : NULL;
+    return count;
+}
+
+O1HeapValidationResult o1heapValidateFull(O1HeapInstance* const handle, const size_t max_fragments)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    if (O1HEAP_UNLIKELY(max_fragments == 0U))
+    {
+        handle->validate_cursor = NULL;  // Abandon the scan in progress, if any.
+        return O1HeapValidationOK;       // MISRA: Early return simplifies control flow.
+    }
+    // Resume from the saved cursor, or start over from the arena base if no scan is in progress.
+    const Fragment* frag = (handle->validate_cursor != NULL)
+                               ? handle->validate_cursor
+                               : (const Fragment*) (const void*) (((char*) handle) + INSTANCE_SIZE_PADDED);
+    for (size_t count = 0U; (frag != NULL) && (count < max_fragments); count++)
+    {
+        if (O1HEAP_UNLIKELY(!validateFragmentDeep(handle, frag)))
+        {
+            handle->validate_cursor = NULL;
+            return O1HeapValidationFailed;  // MISRA: Early return simplifies control flow.
+        }
+        // The raw read is safe: the validation above has bounds-checked the next pointer. The validated next is
+        // always strictly greater than the current address within its chain, so the scan is guaranteed to
+        // terminate; adopted region chains, if any, are then visited once each in table order.
+        const Fragment* next = frag->header.next;
+#if O1HEAP_ENABLE_DONATE
+        if (next == NULL)
+        {
+            next = chainSuccessor(handle, frag);
+        }
+#endif
+        frag = next;
+    }
+    // Intentional violation of MISRA: the cast drops const, which is safe because the cursor is never written
+    // through; the instance merely remembers where the next increment shall resume.
+    handle->validate_cursor = (Fragment*) frag;  // NOSONAR
+    return (frag == NULL) ? O1HeapValidationOK : O1HeapValidationPending;
+}
+
+#if O1HEAP_ENABLE_MARK_RELEASE
+
+size_t o1heapMark(O1HeapInstance* const handle)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    O1HEAP_ASSERT(!handle->mark_active);  // Marks do not nest.
+    handle->mark_active = true;
+    return handle->diagnostics.allocated;
+}
+
+size_t o1heapRelease(O1HeapInstance* const handle)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    O1HEAP_ASSERT(handle->mark_active);  // A release without a matching mark is an error.
+    handle->mark_active = false;
+
+    // Return all internally parked fragments to the heap first. The caches hold used-marked fragments that are
+    // not application objects, so they must not survive the walk below with possibly stale speculative tags.
+#if O1HEAP_ENABLE_DEFERRED_FREE
+    (void) o1heapDrainDeferred(handle);
+#endif
+#if O1HEAP_MAGAZINE_BINS > 0
+    for (uint_fast8_t i = 0U; i < O1HEAP_MAGAZINE_BINS; i++)
+    {
+        magazineFlush(handle, i);
+    }
+#endif
+#if O1HEAP_ENABLE_SCRUB
+    for (size_t i = 0; i < NUM_BINS_MAX; i++)
+    {
+        Fragment* frag         = handle->zeroed_bins[i];
+        handle->zeroed_bins[i] = NULL;
+        while (frag != NULL)
+        {
+            Fragment* const next = frag->next_free;  // Sample before the free because the merge overwrites it.
+            freeFragment(handle, frag, fragGetSize(handle, frag));
+            frag = next;
+        }
+    }
+    if (handle->scrub_frag != NULL)
+    {
+        freeFragment(handle, handle->scrub_frag, fragGetSize(handle, handle->scrub_frag));
+        handle->scrub_frag = NULL;
+        handle->scrub_done = 0U;
+    }
+#endif
+
+    // Reset the bins; they are rebuilt from scratch during the arena walk below.
+    for (size_t i = 0; i < NUM_LISTS_TOTAL; i++)
+    {
+        handle->bins[i] = NULL;
+    }
+#if O1HEAP_SUBBIN_BITS > 0
+    for (size_t i = 0; i < NUM_BINS_MAX; i++)
+    {
+        handle->subbin_masks[i] = 0U;
+    }
+#endif
+    handle->nonempty_bin_mask = 0U;
+#if O1HEAP_TELEMETRY
+    for (size_t i = 0; i < NUM_BINS_MAX; i++)
+    {
+        handle->bin_fragment_counts[i] = 0U;
+    }
+#endif
+
+    // Walk the fragment chain once: free every speculative fragment, collapse each run of adjacent free
+    // fragments into a single one, and rebin the results. The complexity is linear of the number of fragments
+    // in the arena, which is invariant to the number of speculative allocations being rolled back.
+    size_t    released = 0U;
+    Fragment* run      = NULL;  // The first fragment of the current run of free fragments, if any.
+    Fragment* frag     = (Fragment*) (void*) (((char*) handle) + INSTANCE_SIZE_PADDED);
+    while (frag != NULL)
+    {
+        Fragment* next     = fragGetNext(frag);
+        bool      free_now = !fragIsUsed(frag);
+        if ((!free_now) && fragIsSpeculative(frag))
+        {
+            const size_t frag_size = fragGetSize(handle, frag);
+#if O1HEAP_ENABLE_DEFRAG
+            relocRemove(handle, ((char*) frag) + O1HEAP_ALIGNMENT);  // The rollback destroys the object.
+#endif
+            fragSetUsed(frag, false);
+            fragSetSpeculative(frag, false);
+            released += frag_size;
+#if O1HEAP_DIAGNOSTICS
+            O1HEAP_ASSERT(handle->diagnostics.allocated >= frag_size);  // Heap corruption check.
+            handle->diagnostics.allocated -= frag_size;
+#endif
+            free_now = true;
+        }
+        if (free_now)
+        {
+            if (run == NULL)
+            {
+                run = frag;
+            }
+#if O1HEAP_TELEMETRY
+            else
+            {
+                handle->merge_count++;
+            }
+#endif
+        }
+        else if (run != NULL)  // A used fragment terminates the current run.
+        {
+            interlink(run, frag);
+            rebin(handle, run, fragGetSize(handle, run));
+            run = NULL;
+        }
+        else
+        {
+            // Nothing to do: a used fragment with no preceding run.
+        }
+        if (next == NULL)  // The current chain ends with this fragment, possibly inside a run of free ones.
+        {
+            if (run != NULL)  // A free run cannot span across chains because the chains are not contiguous.
+            {
+                interlink(run, NULL);
+                rebin(handle, run, fragGetSize(handle, run));
+                run = NULL;
+            }
+#if O1HEAP_ENABLE_DONATE
+            // Adopted regions hold their own fragment chains, which are subject to the same rollback and
+            // rebinning; skipping them would silently orphan their free fragments from the rebuilt bins.
+            next = chainSuccessor(handle, frag);
+#endif
+        }
+        frag = next;
+    }
+    return released;
+}
+
+#endif  // O1HEAP_ENABLE_MARK_RELEASE
+
+#if O1HEAP_ENABLE_DEFRAG
+
+bool o1heapMakeRelocatable(O1HeapInstance* const handle, void* const pointer, const O1HeapRelocationCallback on_moved)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    O1HEAP_ASSERT(pointer != NULL);
+    // Catch registration of a pointer that does not reference a live allocation in debug builds.
+    O1HEAP_ASSERT(fragIsUsed((const Fragment*) (const void*) (((const char*) pointer) - O1HEAP_ALIGNMENT)));
+    bool         out = true;
+    const size_t idx = relocFind(handle, pointer);
+    if (idx < O1HEAP_DEFRAG_SLOTS)  // Re-registration updates or removes the callback in place.
+    {
+        if (on_moved == NULL)
+        {
+            handle->reloc_pointers[idx]  = NULL;
+            handle->reloc_callbacks[idx] = NULL;
+        }
+        else
+        {
+            handle->reloc_callbacks[idx] = on_moved;
+        }
+    }
+    else if (on_moved != NULL)
+    {
+        size_t free_idx = O1HEAP_DEFRAG_SLOTS;
+        for (size_t i = 0U; (i < O1HEAP_DEFRAG_SLOTS) && (free_idx == O1HEAP_DEFRAG_SLOTS); i++)
+        {
+            if (handle->reloc_pointers[i] == NULL)
+            {
+                free_idx = i;
+            }
+        }
+        if (O1HEAP_LIKELY(free_idx < O1HEAP_DEFRAG_SLOTS))
+        {
+            handle->reloc_pointers[free_idx]  = pointer;
+            handle->reloc_callbacks[free_idx] = on_moved;
+        }
+        else
+        {
+            out = false;  // The table is full; the object simply remains non-relocatable.
+        }
+    }
+    else
+    {
+        // Removing a registration that does not exist is a benign no-op.
     }
     return out;
 }
 
+size_t o1heapDefragStep(O1HeapInstance* const handle, const size_t max_bytes)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    size_t moved = 0U;
+    // Visit every registered object once; the table capacity is a compile-time constant, and the amount of data
+    // moved is bounded by max_bytes, so the cost of one step is bounded irrespective of the heap state.
+    for (size_t i = 0U; i < O1HEAP_DEFRAG_SLOTS; i++)
+    {
+        void* const pointer = handle->reloc_pointers[i];
+        if (pointer != NULL)
+        {
+            Fragment* const frag = (Fragment*) (void*) (((char*) pointer) - O1HEAP_ALIGNMENT);
+            O1HEAP_ASSERT(fragIsUsed(frag));  // The free path removes registrations, so the object must be live.
+            Fragment* const prev      = fragGetPrev(frag);
+            const size_t    frag_size = fragGetSize(handle, frag);
+            // The object is movable iff its left neighbor is free; an object larger than the remaining budget
+            // is skipped on this step and will be revisited by the next one.
+            if ((prev != NULL) && (!fragIsUsed(prev)) && ((moved + frag_size) <= max_bytes))
+            {
+                const size_t prev_size = fragGetSize(handle, prev);
+                unbin(handle, prev, prev_size);
+                // Sample the old header before the move: the destination may overwrite it.
+                Fragment* const next = fragGetNext(frag);
+#if O1HEAP_ENABLE_MARK_RELEASE
+                const bool speculative = fragIsSpeculative(frag);
+#endif
+                void* const new_pointer = ((char*) prev) + O1HEAP_ALIGNMENT;
+                (void) memmove(new_pointer, pointer, frag_size - O1HEAP_ALIGNMENT);
+                fragSetUsed(prev, true);
+#if O1HEAP_ENABLE_MARK_RELEASE
+                fragSetSpeculative(prev, speculative);  // The object retains its identity when moved.
+#endif
+#if O1HEAP_ENABLE_RESERVE
+                fragSetReserved(prev, false);  // The header is written over arbitrary data; clear the flag.
+#endif
+#if O1HEAP_ENABLE_DONATE
+                fragSetDonated(prev, false);  // Same: the garbage in the flag bit shall not survive.
+#endif
+                // The vacated space re-emerges behind the moved object; [ prev ][ frag ][ next ] becomes
+                // [ --- prev --- ][ gap ][ next ], and the gap coalesces with the next fragment if it is free.
+                Fragment* const gap = (Fragment*) (void*) (((char*) prev) + frag_size);
+                fragSetUsed(gap, false);
+#if O1HEAP_ENABLE_MARK_RELEASE
+                fragSetSpeculative(gap, false);  // The header is written over arbitrary data; clear all flags.
+#endif
+                if ((next != NULL) && (!fragIsUsed(next)))
+                {
+                    const size_t next_size = fragGetSize(handle, next);
+                    unbin(handle, next, next_size);
+                    interlink(gap, fragGetNext(next));
+                    interlink(prev, gap);
+                    O1HEAP_ASSERT(fragGetSize(handle, gap) == (prev_size + next_size));
+                    rebin(handle, gap, prev_size + next_size);
+#if O1HEAP_TELEMETRY
+                    handle->merge_count++;
+#endif
+                }
+                else
+                {
+                    interlink(gap, next);
+                    interlink(prev, gap);
+                    O1HEAP_ASSERT(fragGetSize(handle, gap) == prev_size);
+                    rebin(handle, gap, prev_size);
+                }
+                moved += frag_size;
+                handle->reloc_pointers[i] = new_pointer;
+                O1HEAP_ASSERT(handle->reloc_callbacks[i] != NULL);
+                handle->reloc_callbacks[i](pointer, new_pointer);
+            }
+        }
+    }
+    return moved;
+}
+
+#endif  // O1HEAP_ENABLE_DEFRAG
+
 size_t o1heapGetMaxAllocationSize(const O1HeapInstance* const handle)
 {
     O1HEAP_ASSERT(handle != NULL);
+#if O1HEAP_SUBBIN_BITS > 0
+    // With sub-bins, sizes round to the fragment granularity, but the mapping search rounds the request up to the
+    // next sub-bin boundary; return the lower bound of the capacity's sub-bin so that the guarantee always holds.
+    const size_t       units = handle->diagnostics.capacity / FRAGMENT_SIZE_MIN;
+    const uint_fast8_t fl    = log2Floor(units);
+    size_t             lb    = units;
+    if (fl >= O1HEAP_SUBBIN_BITS)
+    {
+        const uint_fast8_t shift = fl - (uint_fast8_t) O1HEAP_SUBBIN_BITS;
+        lb                       = (units >> shift) << shift;
+    }
+    return (lb * FRAGMENT_SIZE_MIN) - O1HEAP_ALIGNMENT;
+#else
     // The largest allocation is smaller (up to almost two times) than the arena capacity,
     // due to the power-of-two padding and the fragment header overhead.
     return pow2(log2Floor(handle->diagnostics.capacity)) - O1HEAP_ALIGNMENT;
+#endif
+}
+
+size_t o1heapGetLargestAvailable(const O1HeapInstance* const handle)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    const size_t mask = handle->nonempty_bin_mask;
+    if (O1HEAP_UNLIKELY(mask == 0U))
+    {
+        return 0U;  // MISRA: Early return simplifies control flow.
+    }
+    const uint_fast8_t fl = log2Floor(mask);  // The largest non-empty size class; one CLZ, like the allocation lookup.
+#if O1HEAP_SUBBIN_BITS > 0
+    // Refine to the topmost non-empty sub-bin of the class and return its lower size bound, which every fragment
+    // in the sub-bin is guaranteed to meet; the mapping-search rounding never escapes the sub-bin for this amount.
+    const size_t sl_mask = handle->subbin_masks[fl];
+    O1HEAP_ASSERT(sl_mask != 0U);
+    const size_t       sl    = (size_t) log2Floor(sl_mask);
+    const uint_fast8_t shift =
+        (fl >= O1HEAP_SUBBIN_BITS) ? (uint_fast8_t) (fl - (uint_fast8_t) O1HEAP_SUBBIN_BITS) : (uint_fast8_t) 0U;
+    const size_t       units = pow2(fl) + (sl << shift);
+    return (units * FRAGMENT_SIZE_MIN) - O1HEAP_ALIGNMENT;
+#else
+    // Every fragment in the topmost bin is at least 2**fl granules large, and a request of that size rounds up
+    // exactly onto the bin, so the returned amount is guaranteed to be allocatable right now.
+    return (pow2(fl) * FRAGMENT_SIZE_MIN) - O1HEAP_ALIGNMENT;
+#endif
 }
 
 bool o1heapDoInvariantsHold(const O1HeapInstance* const handle)
@@ -678,12 +2748,26 @@ bool o1heapDoInvariantsHold(const O1HeapInstance* const handle)
     bool valid = true;
 
     // Check the bin mask consistency.
+#if O1HEAP_SUBBIN_BITS > 0
+    for (size_t i = 0; i < NUM_BINS_MAX; i++)
+    {
+        const bool mask_bit_set = (handle->nonempty_bin_mask & pow2((uint_fast8_t) i)) != 0U;
+        valid                   = valid && (mask_bit_set == (handle->subbin_masks[i] != 0U));
+        for (size_t j = 0; j < SUBBIN_COUNT; j++)
+        {
+            const bool sub_bit_set  = (handle->subbin_masks[i] & pow2((uint_fast8_t) j)) != 0U;
+            const bool bin_nonempty = handle->bins[(i << O1HEAP_SUBBIN_BITS) + j] != NULL;
+            valid                   = valid && (sub_bit_set == bin_nonempty);
+        }
+    }
+#else
     for (size_t i = 0; i < NUM_BINS_MAX; i++)  // Dear compiler, feel free to unroll this loop.
     {
         const bool mask_bit_set = (handle->nonempty_bin_mask & pow2((uint_fast8_t) i)) != 0U;
         const bool bin_nonempty = handle->bins[i] != NULL;
         valid                   = valid && (mask_bit_set == bin_nonempty);
     }
+#endif
 
     // Create a local copy of the diagnostics struct.
     const O1HeapDiagnostics diag = handle->diagnostics;
@@ -692,10 +2776,16 @@ bool o1heapDoInvariantsHold(const O1HeapInstance* const handle)
     valid = valid && (diag.capacity <= FRAGMENT_SIZE_MAX) && (diag.capacity >= FRAGMENT_SIZE_MIN) &&
             ((diag.capacity % FRAGMENT_SIZE_MIN) == 0U);
 
+    // The following checks cover the diagnostic counters, which are only maintained if so configured.
+#if O1HEAP_DIAGNOSTICS
     // Allocation info check.
     valid = valid && (diag.allocated <= diag.capacity) && ((diag.allocated % FRAGMENT_SIZE_MIN) == 0U) &&
-            (diag.peak_allocated <= diag.capacity) && (diag.peak_allocated >= diag.allocated) &&
-            ((diag.peak_allocated % FRAGMENT_SIZE_MIN) == 0U);
+            (diag.peak_allocated >= diag.allocated) && ((diag.peak_allocated % FRAGMENT_SIZE_MIN) == 0U);
+#if !O1HEAP_ENABLE_DONATE
+    // With donation enabled the peak may legitimately exceed the current capacity, because o1heapDonate()
+    // may have shrunk the latter after the peak was reached.
+    valid = valid && (diag.peak_allocated <= diag.capacity);
+#endif
 
     // Peak request check
     valid = valid && ((diag.peak_request_size < diag.capacity) || (diag.oom_count > 0U));
@@ -708,6 +2798,7 @@ bool o1heapDoInvariantsHold(const O1HeapInstance* const handle)
         valid = valid &&  // Overflow on summation is possible but safe to ignore.
                 (((diag.peak_request_size + O1HEAP_ALIGNMENT) <= diag.peak_allocated) || (diag.oom_count > 0U));
     }
+#endif
 
     return valid;
 }
@@ -718,3 +2809,21 @@ O1HeapDiagnostics o1heapGetDiagnostics(const O1HeapInstance* const handle)
     const O1HeapDiagnostics out = handle->diagnostics;
     return out;
 }
+
+#if O1HEAP_TELEMETRY
+
+O1HeapTelemetry o1heapGetTelemetry(const O1HeapInstance* const handle)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    O1HeapTelemetry out;
+    out.nonempty_bin_mask = handle->nonempty_bin_mask;
+    for (size_t i = 0; i < NUM_BINS_MAX; i++)  // Dear compiler, feel free to unroll this loop.
+    {
+        out.bin_fragment_counts[i] = handle->bin_fragment_counts[i];
+    }
+    out.split_count = handle->split_count;
+    out.merge_count = handle->merge_count;
+    return out;
+}
+
+#endif  // O1HEAP_TELEMETRY
@@ -19,6 +19,7 @@
 #ifndef O1HEAP_H_INCLUDED
 #define O1HEAP_H_INCLUDED
 
+#include <limits.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -42,10 +43,10 @@ typedef struct O1HeapInstance O1HeapInstance;
 /// an assertion failure if a heap corruption is detected.
 /// Health checks and validation can be done with o1heapDoInvariantsHold().
 ///
-/// TODO NOTICE: Maintenance of this information takes about a dozen cycles at least, which is quite significant
-/// compared to the amount of computation needed to do the actual memory management. In the future, we may add a
-/// preprocessor option that disables diagnostics for the benefit of the most performance-sensitive applications.
-/// If you find this feature relevant for your use case, consider opening a ticket.
+/// NOTICE: Maintenance of this information takes about a dozen cycles at least, which is quite significant
+/// compared to the amount of computation needed to do the actual memory management. The most performance-sensitive
+/// applications can compile it out by defining O1HEAP_DIAGNOSTICS=0 (e.g., via O1HEAP_CONFIG_HEADER);
+/// in that configuration only the capacity field is valid and the other fields read as zero.
 typedef struct
 {
     /// The total amount of memory available for serving allocation requests (heap size).
@@ -69,8 +70,65 @@ typedef struct
     /// The number of times an allocation request could not be completed due to the lack of memory or
     /// excessive fragmentation. OOM stands for "out of memory". This parameter is never decreased.
     uint64_t oom_count;
+
+    /// The number of times o1heapFree() rejected a pointer that failed the constant-time structural validation
+    /// (double-free or wild pointer) instead of corrupting the heap state. This parameter is never decreased.
+    /// Only maintained if the library is built with O1HEAP_ENABLE_HARDENING=1; reads as zero otherwise.
+    uint64_t bad_free_count;
 } O1HeapDiagnostics;
 
+/// The number of segregated free-fragment bins maintained by the allocator; mirrors the private definition.
+/// Bin at index i holds free fragments of size [2**i, 2**(i+1)) multiplied by (O1HEAP_ALIGNMENT * 2).
+/// Some of the topmost bins are always empty because the size of a fragment cannot exceed the heap capacity.
+/// If the library is built with the capacity capped at 2**O1HEAP_MAX_CAPACITY_LOG2 bytes (see o1heap.c), only the
+/// reachable size classes are provisioned; the macro shall then be defined identically for the library and its
+/// users (e.g., project-wide via the build system) because it affects the layout of O1HeapTelemetry.
+#if defined(O1HEAP_MAX_CAPACITY_LOG2) && (O1HEAP_MAX_CAPACITY_LOG2 > 0)
+#    define O1HEAP_BIN_COUNT                                                                                 \
+        (((O1HEAP_MAX_CAPACITY_LOG2 + 0U) -                                                                  \
+          ((sizeof(void*) == 2U) ? 3U : ((sizeof(void*) == 4U) ? 4U : ((sizeof(void*) == 8U) ? 5U : 6U)))) + \
+         1U)
+#else
+#    define O1HEAP_BIN_COUNT (sizeof(size_t) * CHAR_BIT)
+#endif
+
+/// A constant-time snapshot of the free-space state of the heap; see o1heapGetTelemetry().
+/// While O1HeapDiagnostics describes the allocated side, this structure describes the free side, which is what
+/// one needs to predict external fragmentation and alarm before an allocation actually fails with OOM.
+/// All counters are maintained in constant time on the allocation/deallocation hot paths;
+/// sampling them does not require walking the heap, so the structure can be streamed to a telemetry
+/// channel periodically at a high rate.
+///
+/// This type and o1heapGetTelemetry() are only usable if the library is built with O1HEAP_TELEMETRY=1.
+typedef struct
+{
+    /// Bit at index i is set if bin i is currently non-empty.
+    /// The index of the topmost set bit gives the largest available size class:
+    /// an allocation of x bytes can be served iff a bit is set at an index not lower than
+    /// ceil(log2((x + O1HEAP_ALIGNMENT) / (O1HEAP_ALIGNMENT * 2))).
+    size_t nonempty_bin_mask;
+
+    /// The number of free fragments currently contained in each bin.
+    /// The total number of free fragments in the heap is the sum of all elements.
+    size_t bin_fragment_counts[O1HEAP_BIN_COUNT];
+
+    /// The number of times a fragment has been split in two (e.g., when an allocation is served from a larger
+    /// free fragment). This parameter is never decreased. A high rate indicates fragmentation churn.
+    uint64_t split_count;
+
+    /// The number of times two adjacent fragments have been merged into one (e.g., when freed memory coalesces
+    /// with its neighbors). This parameter is never decreased.
+    uint64_t merge_count;
+} O1HeapTelemetry;
+
+/// The event identifiers passed to the O1HEAP_TRACE_HOOK() profiling macro, which is invoked by o1heapAllocate(),
+/// o1heapFree(), and o1heapReallocate() and expands to nothing unless overridden (see o1heap.c for the details).
+/// The values are stable so that recorded traces remain replayable across library versions.
+/// A reference ring-buffer recorder is provided in the companion module o1heap_trace.c/o1heap_trace.h.
+#define O1HEAP_TRACE_EVENT_ALLOCATE 0U    ///< The pointer is the result (NULL on OOM); the size is the request.
+#define O1HEAP_TRACE_EVENT_FREE 1U        ///< The pointer is the freed pointer; the size is the payload capacity.
+#define O1HEAP_TRACE_EVENT_REALLOCATE 2U  ///< The pointer is the old pointer; the size is the new request.
+
 /// o1heapInit() will fail unless the arena size is at least this large.
 /// This value depends only on the machine architecture.
 /// The other reason to fail is if the arena pointer is not aligned at O1HEAP_ALIGNMENT.
@@ -97,6 +155,78 @@ extern const size_t o1heapMinArenaSize;
 /// The heap is not thread-safe; external synchronization may be required.
 O1HeapInstance* o1heapInit(void* const base, const size_t size);
 
+/// Same as o1heapInit() but only the first initial_committed bytes of the arena are made available for allocation;
+/// the rest is left untouched (not even read) until released incrementally via o1heapExtend().
+/// This is intended for arenas backed by demand-paged virtual memory (e.g. a large mmap on Linux):
+/// starting small and extending as the live set grows keeps the resident set proportional to actual use
+/// instead of faulting in the whole arena upfront.
+/// The initial_committed value is rounded up to the fragment granularity and clamped to the arena capacity;
+/// passing SIZE_MAX makes this function equivalent to o1heapInit(). The reported heap capacity covers only
+/// the committed part and grows with each successful extension.
+O1HeapInstance* o1heapInitLazy(void* const base, const size_t size, const size_t initial_committed);
+
+/// The alignment specifier used by O1HEAP_DEFINE_STATIC(); resolves to the native keyword where one is available.
+/// In strict C99 without GNU extensions no specifier exists; there the macro-defined arena may end up misaligned,
+/// which is detected at runtime by the initialization returning NULL, and manual placement should be used instead.
+#if defined(__cplusplus)
+#    define O1HEAP_ALIGNAS(x) alignas(x)
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#    define O1HEAP_ALIGNAS(x) _Alignas(x)
+#elif defined(__GNUC__) || defined(__clang__) || defined(__CC_ARM)
+#    define O1HEAP_ALIGNAS(x) __attribute__((aligned(x)))
+#else
+#    define O1HEAP_ALIGNAS(x)
+#endif
+
+/// Defines a statically placed heap: a correctly aligned arena of the given size in static storage together with
+/// an accessor function `O1HeapInstance* name(void)` that returns the ready-to-use instance.
+/// This removes all placement boilerplate from the application:
+///
+///     O1HEAP_DEFINE_STATIC(my_heap, 65536)
+///     ...
+///     void* const p = o1heapAllocate(my_heap(), 100);
+///
+/// The instance cannot be laid out as a compile-time initialized image because its layout is private and
+/// configuration-dependent, and it contains absolute pointers into the arena; instead, the initialization --
+/// which amounts to mask arithmetic and a few dozen word stores, with no loops proportional to the arena size --
+/// is folded into the first call of the accessor. Subsequent calls are a single NULL check.
+/// The same single-threaded restriction applies as to the rest of the library: the first call must not race.
+#define O1HEAP_DEFINE_STATIC(name, arena_size)                              \
+    O1HEAP_ALIGNAS(O1HEAP_ALIGNMENT) static unsigned char name##_o1heap_arena[(arena_size)]; \
+    static O1HeapInstance* name(void)                                       \
+    {                                                                       \
+        static O1HeapInstance* instance = NULL;                             \
+        if (instance == NULL)                                               \
+        {                                                                   \
+            instance = o1heapInit(&name##_o1heap_arena[0], (arena_size));   \
+        }                                                                   \
+        return instance;                                                    \
+    }
+
+/// Appends previously uncommitted arena space to the heap of an instance created via o1heapInitLazy().
+/// The requested amount is rounded up to the fragment granularity and clamped to the remaining uncommitted space;
+/// the newly committed space becomes a free fragment, merged with the committed tail if that is free.
+/// Returns the number of bytes actually added, which is zero if the arena is already fully committed.
+/// Writes one fragment header at the new commitment boundary, so at most one new page is faulted in per call.
+/// The time complexity is constant.
+size_t o1heapExtend(O1HeapInstance* const handle, const size_t additional);
+
+/// Migrates free capacity from one live instance to another, allowing coexisting heaps (e.g., separate RX and TX
+/// pools sharing one memory bank) to track a shifting load split without over-provisioning both for their peaks.
+/// A free fragment of at least (min_size + fragment granularity) bytes is located in the source via its bin lookup
+/// mask, removed from the bins, and adopted by the destination as an additional arena region; the lookup is subject
+/// to the same rounding policy as allocation, so the smallest considered fragment may be up to twice min_size.
+/// One granule (twice the alignment) of the donated fragment permanently stays behind in the source as an anchor
+/// that pins the source's fragment chain, so the destination gains (fragment size - granule) bytes of capacity.
+/// Returns the number of capacity bytes gained by the destination; zero means the donation was not possible:
+/// - The source has no suitable free fragment, or donating it would leave the source with no capacity at all.
+/// - The destination has already adopted O1HEAP_DONATE_REGIONS regions (the region table is full).
+/// - The destination capacity would exceed the maximum supported by the build (see O1HEAP_MAX_CAPACITY_LOG2).
+/// Donations are permanent: an adopted region cannot be returned to the original instance.
+/// The time complexity is constant. If the instances are owned by different threads, the caller shall hold the
+/// locks of both. This function is only defined if the library is built with O1HEAP_ENABLE_DONATE=1.
+size_t o1heapDonate(O1HeapInstance* const from, O1HeapInstance* const to, const size_t min_size);
+
 /// The semantics follows malloc() with additional guarantees the full list of which is provided below.
 ///
 /// If the allocation request is served successfully, a pointer to the newly allocated memory fragment is returned.
@@ -109,6 +239,57 @@ O1HeapInstance* o1heapInit(void* const base, const size_t size);
 /// The allocated memory is NOT zero-filled (because zero-filling is a variable-complexity operation).
 void* o1heapAllocate(O1HeapInstance* const handle, const size_t amount);
 
+/// Same as o1heapAllocate() but the returned memory is zero-filled.
+/// If a pre-scrubbed fragment of a suitable size class is available (see o1heapScrubStep()), it is served in
+/// constant time; otherwise the function falls back to a regular allocation followed by an explicit memset,
+/// whose complexity is linear of the amount, and records the miss so that the scrubber can replenish the class.
+///
+/// This function is only defined if the library is built with O1HEAP_ENABLE_SCRUB=1.
+void* o1heapAllocateZeroed(O1HeapInstance* const handle, const size_t amount);
+
+/// Performs at most max_bytes of background zeroing work; intended to be invoked from an idle task.
+/// The scrubber replenishes pre-zeroed fragments for the size classes that o1heapAllocateZeroed() recently
+/// failed to serve in constant time. Memory parked in the pre-scrubbed pool is reported as allocated by the
+/// diagnostics and is returned to the application only via o1heapAllocateZeroed().
+/// Returns the number of bytes zeroed during this call; zero means there is no pending work.
+/// The time complexity is linear of max_bytes and does not depend on the heap state.
+///
+/// This function is only defined if the library is built with O1HEAP_ENABLE_SCRUB=1.
+size_t o1heapScrubStep(O1HeapInstance* const handle, const size_t max_bytes);
+
+/// Allocates count fragments of the same size in one call, writing the resulting pointers into out_pointers.
+/// This is faster than calling o1heapAllocate() in a loop because the size class is resolved once for the whole
+/// batch, and consecutive fragments are carved off one large free fragment in a single pass where possible
+/// (one bin removal, one interlink per fragment, one bin insertion of the leftover).
+/// Returns the number of fragments successfully allocated, which is less than count if the heap cannot serve the
+/// whole batch; the fragments allocated so far remain valid and oom_count is incremented once.
+/// Each returned fragment is independent and may be freed or reallocated individually.
+/// The time complexity is linear of count.
+size_t o1heapAllocateBatch(O1HeapInstance* const handle,
+                           const size_t          amount,
+                           const size_t          count,
+                           void** const          out_pointers);
+
+/// Frees count pointers in one call; each element follows the semantics of o1heapFree() (NULLs are no-ops).
+/// Adjacent fragments freed in the same batch are coalesced irrespective of their order in the array.
+/// The time complexity is linear of count.
+void o1heapFreeBatch(O1HeapInstance* const handle, void* const* const pointers, const size_t count);
+
+/// Same as o1heapAllocate() but the returned pointer is guaranteed to be aligned at the specified alignment,
+/// which shall be an integer power of 2 not smaller than O1HEAP_ALIGNMENT.
+/// The allocation size is increased by the alignment internally, which may push the request into the next
+/// power-of-2 size class; this is the price of alignment beyond the natural O1HEAP_ALIGNMENT.
+/// Memory obtained from this function shall be released with o1heapFreeAligned(), never with o1heapFree(),
+/// and shall not be passed to o1heapReallocate().
+/// Returns NULL if the alignment is invalid or the allocation cannot be served.
+/// The function is executed in constant time.
+void* o1heapAllocateAligned(O1HeapInstance* const handle, const size_t amount, const size_t alignment);
+
+/// Deallocates memory previously obtained from o1heapAllocateAligned(). NULL pointer is a no-op.
+/// If the pointer was not returned by o1heapAllocateAligned(), the behavior is undefined.
+/// The function is executed in constant time.
+void o1heapFreeAligned(O1HeapInstance* const handle, void* const pointer);
+
 /// The semantics follows free() with additional guarantees the full list of which is provided below.
 ///
 /// If the pointer does not point to a previously allocated block and is not NULL, the behavior is undefined.
@@ -117,6 +298,84 @@ void* o1heapAllocate(O1HeapInstance* const handle, const size_t amount);
 /// The function is executed in constant time.
 void o1heapFree(O1HeapInstance* const handle, void* const pointer);
 
+/// Schedules a previously allocated fragment for deallocation from a thread that does not own the heap.
+/// The fragment is pushed onto a lock-free intrusive MPSC (multi-producer single-consumer) stack;
+/// the memory is actually returned to the heap when the owning thread calls o1heapDrainDeferred().
+/// This function may be invoked concurrently from any number of threads (including ISR context on bare metal)
+/// without any locking; all other API functions remain restricted to the single owning thread.
+/// If the pointer is NULL, the function has no effect.
+/// The function is executed in constant time in the absence of contention.
+///
+/// This function is only defined if the library is built with O1HEAP_ENABLE_DEFERRED_FREE=1.
+void o1heapFreeDeferred(O1HeapInstance* const handle, void* const pointer);
+
+/// Returns all fragments previously passed to o1heapFreeDeferred() back to the heap.
+/// Shall only be called by the thread that owns the heap (the one that invokes the other API functions).
+/// Returns the number of fragments freed. The time complexity is linear of the number of pending fragments.
+///
+/// This function is only defined if the library is built with O1HEAP_ENABLE_DEFERRED_FREE=1.
+size_t o1heapDrainDeferred(O1HeapInstance* const handle);
+
+/// Pre-carves up to count fragments, each serving at least the specified amount of bytes, into a private reserve
+/// so that an OOM-critical path (e.g., fault logging) is guaranteed to obtain memory even when the main workload
+/// has exhausted the heap. Reserve fragments are withheld from the general allocation machinery permanently:
+/// o1heapAllocateReserved() pops one in constant time regardless of the bin state, and freeing a fragment that
+/// was obtained from the reserve returns it to the reserve rather than to the general bins, so the guarantee
+/// holds for the lifetime of the instance. Memory held in the reserve is reported as allocated by the
+/// diagnostics. Repeated invocations grow the reserve; using the same amount throughout is recommended because
+/// the reserve is a single LIFO list and the entries are not distinguished by size when popped.
+/// Returns the number of fragments actually added, which is less than count if the heap ran out of memory.
+/// The time complexity is linear of count.
+///
+/// Reallocating a pointer obtained from the reserve (via o1heapReallocate() or o1heapTryExpand()) demotes it
+/// to a regular allocation: the resized fragment will return to the general bins when freed, and the reserve
+/// becomes permanently smaller. Free reserve-obtained pointers with o1heapFree() to retain the guarantee.
+/// If O1HEAP_ENABLE_MARK_RELEASE is in use, fragments obtained from the reserve are never speculative:
+/// they survive o1heapRelease() regardless of when they were popped.
+///
+/// This function is only defined if the library is built with O1HEAP_ENABLE_RESERVE=1.
+size_t o1heapReserve(O1HeapInstance* const handle, const size_t amount, const size_t count);
+
+/// Pops one fragment from the reserve pre-carved by o1heapReserve(); returns NULL if the reserve is empty.
+/// The returned pointer is freed with o1heapFree() like any other allocation, which returns the fragment to
+/// the reserve. The pool state does not affect this function; it succeeds even when o1heapAllocate() reports
+/// OOM. An empty reserve does not count against the OOM statistics. The time complexity is constant.
+///
+/// This function is only defined if the library is built with O1HEAP_ENABLE_RESERVE=1.
+void* o1heapAllocateReserved(O1HeapInstance* const handle);
+
+/// Returns the number of fragments currently parked in the reserve; see o1heapReserve().
+/// The time complexity is constant.
+///
+/// This function is only defined if the library is built with O1HEAP_ENABLE_RESERVE=1.
+size_t o1heapGetReservedCount(const O1HeapInstance* const handle);
+
+/// Begins a speculative allocation episode: every fragment allocated between this call and the matching
+/// o1heapRelease() is tagged so that the release can invalidate all of them at once. This is intended for
+/// transactional workloads that speculatively allocate many objects and must roll them all back on conflict.
+/// Marks do not nest; calling this function while a mark is already active is an error.
+/// Returns the currently allocated amount (the watermark) for the application's own verification;
+/// the value is zero if the library is built with O1HEAP_DIAGNOSTICS=0. The time complexity is constant.
+///
+/// Objects allocated before the mark may be freed during the episode as usual. However, reallocating a pre-mark
+/// object during an episode may move it, in which case the moved copy counts as a speculative allocation and
+/// will be invalidated by the release; avoid reallocation of pre-mark objects while a mark is active.
+///
+/// This function is only defined if the library is built with O1HEAP_ENABLE_MARK_RELEASE=1.
+size_t o1heapMark(O1HeapInstance* const handle);
+
+/// Ends the current speculative allocation episode by freeing every fragment allocated since the matching
+/// o1heapMark(), regardless of how many there are. Fragments held in the internal caches (magazines,
+/// the pre-zeroed pool, the deferred-free stack), if any are enabled, are flushed back to the heap first.
+/// Returns the total number of bytes reclaimed, including the per-fragment overhead and size alignment.
+/// The time complexity is linear of the total number of fragments in the arena (not of the number of
+/// speculative allocations), as the rollback is performed in a single pass over the fragment chain.
+/// Regions adopted via o1heapDonate(), if the library is built with O1HEAP_ENABLE_DONATE=1, are covered by
+/// the rollback the same way as the primary arena.
+///
+/// This function is only defined if the library is built with O1HEAP_ENABLE_MARK_RELEASE=1.
+size_t o1heapRelease(O1HeapInstance* const handle);
+
 /// Similar to the standard realloc() with a few improvements. Given a previously allocated fragment and a new size,
 /// attempts to resize the fragment.
 ///
@@ -146,10 +405,138 @@ void o1heapFree(O1HeapInstance* const handle, void* const pointer);
 /// Every other case is constant-complexity as the data is not moved.
 void* o1heapReallocate(O1HeapInstance* const handle, void* const pointer, const size_t new_amount);
 
+/// A non-moving counterpart of o1heapReallocate() for growth only: attempts to expand the fragment in place
+/// and returns falsity instead of relocating the data if that is not possible.
+/// On success the pointer remains valid and the fragment accommodates at least new_amount bytes;
+/// the contents of the grown part is undefined. On failure the fragment is left unchanged.
+/// Returns truth immediately if the fragment is already large enough (the fragment is never shrunk).
+/// If the pointer is NULL or does not point to a valid allocated fragment, the behavior is undefined.
+/// This is intended for zero-copy buffer management where chaining a new buffer is cheaper than copying.
+/// The time complexity is constant.
+bool o1heapTryExpand(O1HeapInstance* const handle, void* const pointer, const size_t new_amount);
+
+/// A growth-hinted variant of o1heapReallocate() for buffers that are known to keep growing, such as incremental
+/// message reassembly. The semantics match o1heapReallocate() except that whenever the data has to be moved (or
+/// the pointer is NULL), the new fragment is sized for max(new_amount, expected_final) instead of new_amount, so
+/// that all subsequent growth steps up to expected_final are served by the constant-time in-place expansion and
+/// the payload is copied at most once instead of once per growth step. The fragment is intentionally never shrunk:
+/// the slack is the headroom that prevents the next move. If a fragment sized for the hint cannot be allocated,
+/// the hint is dropped and the call degrades to a plain o1heapReallocate(), which may still succeed in place by
+/// merging with free neighbors. Pass expected_final=0 (or any value not greater than new_amount) for the plain
+/// unhinted behavior. The complexity cases are the same as those of o1heapReallocate().
+void* o1heapReallocateHinted(O1HeapInstance* const handle,
+                             void* const           pointer,
+                             const size_t          new_amount,
+                             const size_t          expected_final);
+
+/// Returns the usable payload capacity of the previously allocated fragment, in bytes.
+/// This is at least as large as the amount requested at allocation due to the size rounding,
+/// so the caller may use the entire returned capacity without reallocating.
+/// If the pointer is NULL, zero is returned; if it does not point to a valid allocated fragment,
+/// the behavior is undefined. The time complexity is constant.
+size_t o1heapGetAllocatedSize(const O1HeapInstance* const handle, const void* const pointer);
+
 /// Obtains the maximum theoretically possible allocation size for this heap instance.
 /// This is useful when implementing std::allocator_traits<Alloc>::max_size.
 size_t o1heapGetMaxAllocationSize(const O1HeapInstance* const handle);
 
+/// Returns an amount that o1heapAllocate() is guaranteed to serve successfully right now, derived from the
+/// topmost set bit of the free-bin lookup mask. Unlike o1heapGetMaxAllocationSize(), which is a static bound
+/// computed from the capacity, this reflects the current free-space state, so an adaptive producer can downshift
+/// its request (e.g., reduce buffer resolution) before hitting the OOM path instead of burning a failed,
+/// oom_count-incrementing attempt followed by a retry.
+/// The value is a guaranteed lower bound, not a tight one: the largest free fragment may be up to almost twice
+/// as large (the exact size cannot be derived from the bin index alone). Zero is returned iff no free fragment
+/// exists. Memory parked in the internal caches (magazines, the pre-zeroed pool), if any are enabled, is not
+/// considered because it is not in the bins. The time complexity is constant (one CLZ, like the allocation
+/// lookup).
+size_t o1heapGetLargestAvailable(const O1HeapInstance* const handle);
+
+/// The fragment visitor callback for o1heapIterate(). The payload pointer is what o1heapAllocate() would have
+/// returned for the fragment; the capacity is its usable payload size (the per-fragment overhead is excluded);
+/// the used flag tells whether the fragment is currently allocated. Returning falsity aborts the walk.
+/// The callback shall not modify the heap.
+typedef bool (*O1HeapFragmentCallback)(void* const  context,
+                                       void* const  payload,
+                                       const size_t capacity,
+                                       const bool   used);
+
+/// Walks the address-ordered fragment chain, reporting every fragment -- used and free alike -- to the callback.
+/// This enables leak and lifetime auditing (e.g., dumping what is still allocated before a soft reset) without
+/// any knowledge of the private fragment layout; only state the allocator already maintains is read.
+/// At most max_fragments fragments are visited per call so the walk can be chunked across idle-time slices:
+/// if the cap is reached, the position is retained and the next call resumes from it; when the walk reaches the
+/// end of the arena or is aborted by the callback, the position is reset and the next call starts over.
+/// Calling with max_fragments of zero only resets the position and returns zero.
+/// Any allocation, deallocation, or reallocation invalidates a walk in progress; the caller shall then reset
+/// the position and start over, otherwise the behavior is undefined.
+/// Fragments parked in the internal caches (magazines, the pre-zeroed pool, the deferred-free stack), if any
+/// are enabled, are reported as used because they are allocated-shaped; the uncommitted tail of a lazily
+/// initialized arena is not reported at all. Regions adopted via o1heapDonate(), if the library is built with
+/// O1HEAP_ENABLE_DONATE=1, are walked after the primary arena, so every fragment of the heap is reported;
+/// on the donor side, the anchor left behind by a donation is allocator-owned like the uncommitted tail and is
+/// likewise not reported (its nominal extent spans memory owned by the recipient instance).
+/// Returns the number of fragments visited during this call; a value less than max_fragments means the walk
+/// has completed (or was aborted). The time complexity is linear of max_fragments.
+size_t o1heapIterate(O1HeapInstance* const        handle,
+                     const O1HeapFragmentCallback callback,
+                     void* const                  context,
+                     const size_t                 max_fragments);
+
+/// The owner notification callback for relocatable objects; see o1heapMakeRelocatable().
+/// It is invoked by o1heapDefragStep() after the object has been moved: the data has already been copied to the
+/// new location when the callback runs, so the owner only needs to update its pointers. The callback must not
+/// call back into the heap.
+typedef void (*O1HeapRelocationCallback)(void* const old_pointer, void* const new_pointer);
+
+/// Registers a previously allocated fragment as relocatable, permitting o1heapDefragStep() to move it in order
+/// to reclaim contiguous free space. The owner is notified of each such move through the callback.
+/// Passing a NULL callback removes an existing registration (a no-op if the pointer is not registered).
+/// The registration follows the object: freeing the pointer removes it, and a reallocation that moves the data
+/// re-points it automatically (without invoking the callback, as the owner receives the new pointer directly).
+/// Returns falsity iff a new registration was requested but the table is full; the table capacity is set at
+/// compile time via O1HEAP_DEFRAG_SLOTS. The time complexity is constant.
+///
+/// This function is only defined if the library is built with O1HEAP_ENABLE_DEFRAG=1.
+bool o1heapMakeRelocatable(O1HeapInstance* const handle, void* const pointer, const O1HeapRelocationCallback on_moved);
+
+/// Performs one bounded increment of heap defragmentation: registered relocatable objects are slid towards lower
+/// addresses into adjacent free space, merging the vacated space with its neighbors, until either all candidates
+/// have been visited or the relocation budget is exhausted. At most max_bytes are relocated per call (an object
+/// larger than the remaining budget is skipped), so the per-step cost is bounded and the work can be spread over
+/// idle time while the heap remains usable between the steps.
+/// Returns the number of bytes relocated; zero means no further compaction is currently possible with this budget.
+/// The time complexity is bounded by O1HEAP_DEFRAG_SLOTS and max_bytes regardless of the heap state.
+///
+/// This function is only defined if the library is built with O1HEAP_ENABLE_DEFRAG=1.
+size_t o1heapDefragStep(O1HeapInstance* const handle, const size_t max_bytes);
+
+/// The result of one o1heapValidateFull() increment; see that function for the details.
+typedef enum
+{
+    O1HeapValidationOK      = 0,  ///< The inspected fragments are consistent and the scan has completed.
+    O1HeapValidationPending = 1,  ///< The inspected fragments are consistent; more remain to be scanned.
+    O1HeapValidationFailed  = 2,  ///< An inconsistency was detected; the heap shall be considered corrupted.
+} O1HeapValidationResult;
+
+/// Performs one bounded increment of a deep heap integrity scan. Unlike the constant-time
+/// o1heapDoInvariantsHold(), this verifies the full fragment chain: the next/prev interlinking symmetry,
+/// the size invariants (multiples of the fragment granularity within the capacity), the coalescing invariant
+/// (no two adjacent free fragments), and for every free fragment the segregated-list linkage and its coverage
+/// by the bin lookup masks. Only raw bounds-checked reads are used, so the scan reports corruption gracefully
+/// instead of faulting, which makes it suitable for release builds where assertions are compiled out.
+/// Regions adopted via o1heapDonate(), if the library is built with O1HEAP_ENABLE_DONATE=1, are scanned after
+/// the primary arena, so the verification covers the entire heap.
+/// At most max_fragments fragments are inspected per call so the scan can run as a periodic background task
+/// with bounded interference: O1HeapValidationPending means the position was retained and the next call resumes
+/// from it; O1HeapValidationOK means the scan has completed cleanly and the next call starts over.
+/// O1HeapValidationFailed means an inconsistency was found; the scan position is reset.
+/// Calling with max_fragments of zero only resets the position and returns O1HeapValidationOK.
+/// Any allocation, deallocation, or reallocation invalidates a scan in progress; the caller shall then reset
+/// the position and start over, otherwise the behavior is undefined.
+/// The time complexity is linear of max_fragments.
+O1HeapValidationResult o1heapValidateFull(O1HeapInstance* const handle, const size_t max_fragments);
+
 /// Performs a basic sanity check on the heap.
 /// This function can be used as a weak but fast method of heap corruption detection.
 /// If the handle pointer is NULL, the behavior is undefined.
@@ -162,6 +549,13 @@ bool o1heapDoInvariantsHold(const O1HeapInstance* const handle);
 /// If the handle pointer is NULL, the behavior is undefined.
 O1HeapDiagnostics o1heapGetDiagnostics(const O1HeapInstance* const handle);
 
+/// Samples and returns a copy of the free-space telemetry, see O1HeapTelemetry.
+/// This function merely copies fixed-size counters from an internal storage, so it executes in constant time.
+/// If the handle pointer is NULL, the behavior is undefined.
+///
+/// This function is only defined if the library is built with O1HEAP_TELEMETRY=1.
+O1HeapTelemetry o1heapGetTelemetry(const O1HeapInstance* const handle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,167 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+//
+// This is an optional header-only companion for C++17 applications implemented on top of the core C library.
+// It adapts an O1HeapInstance to the standard allocator interfaces so that standard containers can live in the
+// arena: o1heap::MemoryResource implements std::pmr::memory_resource for the polymorphic containers
+// (std::pmr::vector, std::pmr::unordered_map, etc.), and o1heap::Allocator is a stateful allocator template for
+// the classic ones. Both are thin non-owning views: copying them does not copy the heap, destroying them does
+// not destroy the heap, and all complexity guarantees of the underlying C API apply unchanged.
+// The usual o1heap threading rules apply: one instance shall not be accessed concurrently without locking.
+
+#ifndef O1HEAP_HPP_INCLUDED
+#define O1HEAP_HPP_INCLUDED
+
+#include "o1heap.h"
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+namespace o1heap
+{
+/// A std::pmr::memory_resource view of an O1HeapInstance; use it with std::pmr containers via the pointer:
+///
+///     o1heap::MemoryResource resource(heap);
+///     std::pmr::vector<std::uint8_t> record(&resource);
+///
+/// Per the memory_resource contract, do_allocate() reports failure by throwing std::bad_alloc; the OOM is also
+/// counted in the heap diagnostics as usual. Alignment requests stricter than O1HEAP_ALIGNMENT are honored via
+/// o1heapAllocateAligned() at the cost of the documented overhead; the common case maps straight onto
+/// o1heapAllocate() and o1heapFree() with zero wrapper overhead.
+class MemoryResource final : public std::pmr::memory_resource
+{
+public:
+    explicit MemoryResource(O1HeapInstance* const instance) noexcept : instance_(instance) {}
+
+    /// The underlying heap, e.g., for querying the diagnostics. Never nullptr.
+    O1HeapInstance* instance() const noexcept { return instance_; }
+
+protected:
+    void* do_allocate(const std::size_t bytes, const std::size_t alignment) override
+    {
+        // A zero-size request shall still return a unique non-null pointer per the memory_resource contract.
+        const std::size_t amount = (bytes > 0U) ? bytes : 1U;
+        void* const       out    = (alignment <= O1HEAP_ALIGNMENT) ? o1heapAllocate(instance_, amount)
+                                                                   : o1heapAllocateAligned(instance_, amount, alignment);
+        if (out == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return out;
+    }
+
+    void do_deallocate(void* const pointer, const std::size_t bytes, const std::size_t alignment) override
+    {
+        (void) bytes;  // o1heap tracks the fragment size internally; the caller-supplied size is not needed.
+        if (alignment <= O1HEAP_ALIGNMENT)
+        {
+            o1heapFree(instance_, pointer);
+        }
+        else
+        {
+            o1heapFreeAligned(instance_, pointer);
+        }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+#if defined(__cpp_rtti) && (__cpp_rtti != 0)
+        // Two views of the same heap are interchangeable: memory from one can be released through the other.
+        const auto* const that = dynamic_cast<const MemoryResource*>(&other);
+        return (that != nullptr) && (that->instance_ == instance_);
+#else
+        return this == &other;  // Conservative fallback for builds without RTTI.
+#endif
+    }
+
+private:
+    O1HeapInstance* instance_;
+};
+
+/// A stateful C++17 allocator view of an O1HeapInstance for the classic (non-pmr) containers:
+///
+///     std::vector<std::uint8_t, o1heap::Allocator<std::uint8_t>> record(o1heap::Allocator<std::uint8_t>(heap));
+///
+/// allocate() reports failure by throwing std::bad_alloc; max_size() is derived from
+/// o1heapGetMaxAllocationSize() so that std::allocator_traits<Alloc>::max_size() reflects the actual arena.
+/// Over-aligned value types are supported via o1heapAllocateAligned(). Allocators viewing the same heap compare
+/// equal, so containers may exchange memory between them freely.
+template <typename T>
+class Allocator
+{
+public:
+    using value_type = T;
+
+    explicit Allocator(O1HeapInstance* const instance) noexcept : instance_(instance) {}
+
+    template <typename U>
+    Allocator(const Allocator<U>& other) noexcept : instance_(other.instance())  // NOLINT implicit by design
+    {
+    }
+
+    T* allocate(const std::size_t count)
+    {
+        if (count > max_size())  // Also excludes the multiplication overflow.
+        {
+            throw std::bad_alloc();
+        }
+        void* const out = (alignof(T) <= O1HEAP_ALIGNMENT)
+                              ? o1heapAllocate(instance_, count * sizeof(T))
+                              : o1heapAllocateAligned(instance_, count * sizeof(T), alignof(T));
+        if (out == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(out);
+    }
+
+    void deallocate(T* const pointer, const std::size_t count) noexcept
+    {
+        (void) count;  // o1heap tracks the fragment size internally; the caller-supplied size is not needed.
+        if (alignof(T) <= O1HEAP_ALIGNMENT)
+        {
+            o1heapFree(instance_, pointer);
+        }
+        else
+        {
+            o1heapFreeAligned(instance_, pointer);
+        }
+    }
+
+    std::size_t max_size() const noexcept { return o1heapGetMaxAllocationSize(instance_) / sizeof(T); }
+
+    /// The underlying heap, e.g., for querying the diagnostics. Never nullptr.
+    O1HeapInstance* instance() const noexcept { return instance_; }
+
+private:
+    O1HeapInstance* instance_;
+};
+
+template <typename A, typename B>
+bool operator==(const Allocator<A>& lhs, const Allocator<B>& rhs) noexcept
+{
+    return lhs.instance() == rhs.instance();
+}
+
+template <typename A, typename B>
+bool operator!=(const Allocator<A>& lhs, const Allocator<B>& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+}  // namespace o1heap
+
+#endif  // O1HEAP_HPP_INCLUDED
@@ -0,0 +1,155 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+#include "o1heap_locked.h"
+#include <assert.h>
+
+/// Define this macro to include build configuration header. This is an alternative to the -D compiler flag.
+#ifdef O1HEAP_CONFIG_HEADER
+#    include O1HEAP_CONFIG_HEADER
+#endif
+
+/// The assertion macro defaults to the standard assert(), same as in the core library.
+#ifndef O1HEAP_ASSERT
+// Intentional violation of MISRA: the assertion check macro cannot be replaced with a function definition.
+#    define O1HEAP_ASSERT(x) assert(x)  // NOSONAR
+#endif
+
+/// The critical-section primitives shall be supplied via O1HEAP_CONFIG_HEADER (or the -D compiler flag);
+/// there is no sensible platform-independent default, so missing definitions are a configuration error.
+/// Both macros receive the opaque lock context registered at o1heapInitLocked().
+/// Examples: PRIMASK save/disable & restore on bare-metal Cortex-M; pthread_mutex_lock/unlock on POSIX.
+///
+/// The optional O1HEAP_CRITICAL_SECTION_TRY_ENTER(lock_context) macro, if defined, shall attempt to enter the
+/// critical section without blocking and evaluate to truth on success. When available, it is used to maintain
+/// the contention counter: a failed attempt is counted and followed by the blocking enter.
+#if !defined(O1HEAP_CRITICAL_SECTION_ENTER) || !defined(O1HEAP_CRITICAL_SECTION_EXIT)
+#    error "o1heap_locked requires O1HEAP_CRITICAL_SECTION_ENTER/EXIT definitions; see O1HEAP_CONFIG_HEADER."
+#endif
+
+struct O1HeapLockedInstance
+{
+    O1HeapInstance* heap;
+    void*           lock;  ///< The opaque user lock context passed to the critical-section macros.
+    /// The number of contended entries; only maintained if O1HEAP_CRITICAL_SECTION_TRY_ENTER is defined.
+    /// Modified strictly inside the critical section so that no atomicity requirements arise.
+    uint64_t contention_count;
+};
+
+/// Same padding policy as for the core instance: keeps the wrapped heap aligned at O1HEAP_ALIGNMENT.
+#define LOCKED_INSTANCE_SIZE_PADDED ((sizeof(O1HeapLockedInstance) + O1HEAP_ALIGNMENT - 1U) & ~(O1HEAP_ALIGNMENT - 1U))
+
+/// Enters the critical section, counting the entry as contended if the non-blocking attempt fails first.
+/// The counter itself is incremented only after the lock is held to keep its accesses serialized.
+static void lockedEnter(O1HeapLockedInstance* const self)
+{
+#ifdef O1HEAP_CRITICAL_SECTION_TRY_ENTER
+    if (O1HEAP_CRITICAL_SECTION_TRY_ENTER(self->lock))
+    {
+        (void) 0;
+    }
+    else
+    {
+        O1HEAP_CRITICAL_SECTION_ENTER(self->lock);
+        self->contention_count++;
+    }
+#else
+    O1HEAP_CRITICAL_SECTION_ENTER(self->lock);
+#endif
+}
+
+static void lockedExit(O1HeapLockedInstance* const self)
+{
+    O1HEAP_CRITICAL_SECTION_EXIT(self->lock);
+}
+
+size_t o1heapLockedMinArenaSize(void)
+{
+    return LOCKED_INSTANCE_SIZE_PADDED + o1heapMinArenaSize;
+}
+
+O1HeapLockedInstance* o1heapInitLocked(void* const base, const size_t size, void* const lock_context)
+{
+    O1HeapLockedInstance* out = NULL;
+    if ((base != NULL) && ((((size_t) base) % O1HEAP_ALIGNMENT) == 0U) && (size >= o1heapLockedMinArenaSize()))
+    {
+        out                   = (O1HeapLockedInstance*) base;
+        out->lock             = lock_context;
+        out->contention_count = 0U;
+        out->heap = o1heapInit(((char*) base) + LOCKED_INSTANCE_SIZE_PADDED, size - LOCKED_INSTANCE_SIZE_PADDED);
+        O1HEAP_ASSERT(out->heap != NULL);  // Cannot fail: the base is aligned and the size has been checked.
+    }
+    return out;
+}
+
+void* o1heapLockedAllocate(O1HeapLockedInstance* const handle, const size_t amount)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    lockedEnter(handle);
+    void* const out = o1heapAllocate(handle->heap, amount);
+    lockedExit(handle);
+    return out;
+}
+
+void o1heapLockedFree(O1HeapLockedInstance* const handle, void* const pointer)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    lockedEnter(handle);
+    o1heapFree(handle->heap, pointer);
+    lockedExit(handle);
+}
+
+void* o1heapLockedReallocate(O1HeapLockedInstance* const handle, void* const pointer, const size_t new_amount)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    lockedEnter(handle);
+    void* const out = o1heapReallocate(handle->heap, pointer, new_amount);
+    lockedExit(handle);
+    return out;
+}
+
+bool o1heapLockedDoInvariantsHold(O1HeapLockedInstance* const handle)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    lockedEnter(handle);
+    const bool out = o1heapDoInvariantsHold(handle->heap);
+    lockedExit(handle);
+    return out;
+}
+
+O1HeapDiagnostics o1heapLockedGetDiagnostics(O1HeapLockedInstance* const handle)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    lockedEnter(handle);
+    const O1HeapDiagnostics out = o1heapGetDiagnostics(handle->heap);
+    lockedExit(handle);
+    return out;
+}
+
+uint64_t o1heapLockedGetContentionCount(O1HeapLockedInstance* const handle)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    lockedEnter(handle);
+    const uint64_t out = handle->contention_count;
+    lockedExit(handle);
+    return out;
+}
+
+O1HeapInstance* o1heapLockedGetHeap(const O1HeapLockedInstance* const handle)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    return handle->heap;
+}
@@ -0,0 +1,81 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+//
+// This is an optional companion module implemented on top of the core library (o1heap.c/o1heap.h).
+// It wraps a heap instance in user-supplied critical sections so that every entry point -- including the
+// diagnostics sampling, whose 64-bit counters are prone to torn reads on 32-bit targets -- is protected
+// consistently, instead of each application re-implementing (and mis-implementing) the same mutex wrapper.
+// The critical-section primitives are supplied as macros via O1HEAP_CONFIG_HEADER (see o1heap_locked.c),
+// mapping to PRIMASK manipulation on bare metal or a mutex on POSIX. The core library itself remains lock-free;
+// applications that own their heap from a single context should not compile this module.
+
+#ifndef O1HEAP_LOCKED_H_INCLUDED
+#define O1HEAP_LOCKED_H_INCLUDED
+
+#include "o1heap.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The definition is private, so the user code can only operate on pointers. This is done to enforce encapsulation.
+typedef struct O1HeapLockedInstance O1HeapLockedInstance;
+
+/// o1heapInitLocked() will fail unless the arena size is at least this large.
+/// The locking-layer bookkeeping structure is carved from the arena, hence the extra overhead over
+/// o1heapMinArenaSize.
+size_t o1heapLockedMinArenaSize(void);
+
+/// Initializes a locked heap over the given arena; the semantics follow o1heapInit().
+/// The lock_context is an opaque pointer passed through to the critical-section macros on every entry;
+/// it typically points to the mutex protecting this heap (it may be NULL if the macros ignore it,
+/// e.g. PRIMASK-based bare-metal implementations). The initialization itself is not locked:
+/// the instance must not be published to other threads before this function returns.
+O1HeapLockedInstance* o1heapInitLocked(void* const base, const size_t size, void* const lock_context);
+
+/// The semantics follow o1heapAllocate(); the call is executed inside a critical section.
+void* o1heapLockedAllocate(O1HeapLockedInstance* const handle, const size_t amount);
+
+/// The semantics follow o1heapFree(); the call is executed inside a critical section.
+void o1heapLockedFree(O1HeapLockedInstance* const handle, void* const pointer);
+
+/// The semantics follow o1heapReallocate(); the call is executed inside a critical section.
+void* o1heapLockedReallocate(O1HeapLockedInstance* const handle, void* const pointer, const size_t new_amount);
+
+/// The semantics follow o1heapDoInvariantsHold(); the call is executed inside a critical section.
+bool o1heapLockedDoInvariantsHold(O1HeapLockedInstance* const handle);
+
+/// The semantics follow o1heapGetDiagnostics(); the call is executed inside a critical section,
+/// so the returned snapshot is consistent and the 64-bit counters cannot be read torn.
+O1HeapDiagnostics o1heapLockedGetDiagnostics(O1HeapLockedInstance* const handle);
+
+/// Returns the number of times an entry point found the lock already taken, which is only counted if the optional
+/// O1HEAP_CRITICAL_SECTION_TRY_ENTER macro is defined (reads as zero otherwise). A growing rate indicates that
+/// the heap is becoming a point of contention and the workload may be better served by per-core instances
+/// (see o1heap_sharded.h). The sample is taken inside a critical section.
+uint64_t o1heapLockedGetContentionCount(O1HeapLockedInstance* const handle);
+
+/// Returns the underlying heap instance for use with core API functions not wrapped by this module.
+/// The caller assumes responsibility for the locking of any such calls.
+O1HeapInstance* o1heapLockedGetHeap(const O1HeapLockedInstance* const handle);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // O1HEAP_LOCKED_H_INCLUDED
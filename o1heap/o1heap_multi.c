@@ -0,0 +1,168 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+#include "o1heap_multi.h"
+#include <assert.h>
+
+/// Define this macro to include build configuration header. This is an alternative to the -D compiler flag.
+#ifdef O1HEAP_CONFIG_HEADER
+#    include O1HEAP_CONFIG_HEADER
+#endif
+
+/// The assertion macro defaults to the standard assert(), same as in the core library.
+#ifndef O1HEAP_ASSERT
+// Intentional violation of MISRA: the assertion check macro cannot be replaced with a function definition.
+#    define O1HEAP_ASSERT(x) assert(x)  // NOSONAR
+#endif
+
+/// The hard upper limit on the number of registered memory regions. It bounds the size of the multi-arena instance
+/// structure and the worst-case execution time of the overflow and free-routing paths. Real systems rarely feature
+/// more than a handful of distinct memory regions (e.g. TCM, on-chip SRAM, external RAM); the default can be
+/// overridden via O1HEAP_CONFIG_HEADER if needed.
+#ifndef O1HEAP_MULTI_MAX_ARENAS
+#    define O1HEAP_MULTI_MAX_ARENAS 4U
+#endif
+
+/// One registered memory region. The address bounds are kept here because the core library does not expose the
+/// extents of its arena; they are needed to route frees back to the owning region.
+typedef struct
+{
+    O1HeapInstance* heap;
+    const char*     base;  ///< First byte of the region.
+    size_t          size;  ///< Total size of the region including the per-region instance overhead.
+} MultiArena;
+
+struct O1HeapMultiInstance
+{
+    MultiArena arenas[O1HEAP_MULTI_MAX_ARENAS];
+    size_t     num_arenas;
+};
+
+/// Same padding policy as for the core instance: keeps the first region's heap aligned at O1HEAP_ALIGNMENT.
+#define MULTI_INSTANCE_SIZE_PADDED ((sizeof(O1HeapMultiInstance) + O1HEAP_ALIGNMENT - 1U) & ~(O1HEAP_ALIGNMENT - 1U))
+
+size_t o1heapMultiMinArenaSize(void)
+{
+    return MULTI_INSTANCE_SIZE_PADDED + o1heapMinArenaSize;
+}
+
+O1HeapMultiInstance* o1heapInitMulti(void* const base, const size_t size)
+{
+    O1HeapMultiInstance* out = NULL;
+    if ((base != NULL) && ((((size_t) base) % O1HEAP_ALIGNMENT) == 0U) && (size >= o1heapMultiMinArenaSize()))
+    {
+        out             = (O1HeapMultiInstance*) base;
+        out->num_arenas = 0U;
+        for (size_t i = 0U; i < O1HEAP_MULTI_MAX_ARENAS; i++)
+        {
+            out->arenas[i].heap = NULL;
+            out->arenas[i].base = NULL;
+            out->arenas[i].size = 0U;
+        }
+        // The first (fastest) region hosts the multi-arena bookkeeping structure; its heap manages the remainder.
+        O1HeapInstance* const heap =
+            o1heapInit(((char*) base) + MULTI_INSTANCE_SIZE_PADDED, size - MULTI_INSTANCE_SIZE_PADDED);
+        if (heap != NULL)
+        {
+            out->arenas[0].heap = heap;
+            out->arenas[0].base = (const char*) base;
+            out->arenas[0].size = size;
+            out->num_arenas     = 1U;
+        }
+        else
+        {
+            out = NULL;  // MISRA: Single point of exit requires explicit unwinding here.
+        }
+    }
+    return out;
+}
+
+bool o1heapMultiAddArena(O1HeapMultiInstance* const handle, void* const base, const size_t size)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    bool out = false;
+    if ((base != NULL) && ((((size_t) base) % O1HEAP_ALIGNMENT) == 0U) &&
+        (handle->num_arenas < O1HEAP_MULTI_MAX_ARENAS))
+    {
+        O1HeapInstance* const heap = o1heapInit(base, size);  // Fails if the region is too small.
+        if (heap != NULL)
+        {
+            MultiArena* const a = &handle->arenas[handle->num_arenas];
+            a->heap             = heap;
+            a->base             = (const char*) base;
+            a->size             = size;
+            handle->num_arenas++;
+            out = true;
+        }
+    }
+    return out;
+}
+
+void* o1heapMultiAllocate(O1HeapMultiInstance* const handle, const size_t amount)
+{
+    return o1heapMultiAllocateHinted(handle, amount, O1HeapMultiHintFast);
+}
+
+void* o1heapMultiAllocateHinted(O1HeapMultiInstance* const handle, const size_t amount, const O1HeapMultiHint hint)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    O1HEAP_ASSERT(handle->num_arenas > 0U);
+    // The regions are tried in the order implied by the hint; the first success wins, turning per-region OOM into
+    // automatic overflow. The loop is bounded by the number of regions, which is a small compile-time-bounded
+    // constant, so the worst case remains constant for a given configuration.
+    void* out = NULL;
+    for (size_t i = 0U; (i < handle->num_arenas) && (out == NULL); i++)
+    {
+        const size_t idx = (hint == O1HeapMultiHintSlow) ? (handle->num_arenas - 1U - i) : i;
+        out              = o1heapAllocate(handle->arenas[idx].heap, amount);
+    }
+    return out;
+}
+
+void o1heapMultiFree(O1HeapMultiInstance* const handle, void* const pointer)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    if (pointer != NULL)  // NULL pointer is a no-op.
+    {
+        // Route the fragment back to its owning region, which is identified from the address. The regions may be
+        // located anywhere in the address space, so unlike the sharded module a bounded linear scan is required.
+        const char* const pt    = (const char*) pointer;
+        bool              found = false;
+        for (size_t i = 0U; (i < handle->num_arenas) && !found; i++)
+        {
+            const MultiArena* const a = &handle->arenas[i];
+            // The comparisons are arranged so that they cannot overflow even for wild pointer values.
+            if ((pt >= a->base) && ((size_t) (pt - a->base) < a->size))
+            {
+                o1heapFree(a->heap, pointer);
+                found = true;
+            }
+        }
+        O1HEAP_ASSERT(found);  // The pointer does not belong to any registered region; this is heap corruption.
+    }
+}
+
+size_t o1heapMultiGetArenaCount(const O1HeapMultiInstance* const handle)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    return handle->num_arenas;
+}
+
+O1HeapInstance* o1heapMultiGetArena(const O1HeapMultiInstance* const handle, const size_t index)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    return (index < handle->num_arenas) ? handle->arenas[index].heap : NULL;
+}
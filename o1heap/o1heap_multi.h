@@ -0,0 +1,94 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+//
+// This is an optional companion module implemented on top of the core library (o1heap.c/o1heap.h).
+// It is intended for systems with several discontiguous memory regions of different speed (e.g. DTCM plus
+// external SRAM): one logical heap spans all registered regions, allocations prefer the fastest region that
+// can serve them and overflow into the slower ones instead of failing with OOM, and frees are routed back to
+// the owning region automatically. Each region is managed by a regular O1HeapInstance, so all per-region
+// guarantees of the core library hold. Applications with a single memory region should not compile this module.
+
+#ifndef O1HEAP_MULTI_H_INCLUDED
+#define O1HEAP_MULTI_H_INCLUDED
+
+#include "o1heap.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The definition is private, so the user code can only operate on pointers. This is done to enforce encapsulation.
+typedef struct O1HeapMultiInstance O1HeapMultiInstance;
+
+/// The allocation affinity hint; see o1heapMultiAllocateHinted().
+/// Regions are ranked by registration order: the region passed to o1heapInitMulti() is the fastest,
+/// each subsequently added region is assumed to be slower than the previous one.
+typedef enum
+{
+    O1HeapMultiHintFast = 0,  ///< Prefer the fastest region; overflow towards the slower ones. This is the default.
+    O1HeapMultiHintSlow = 1   ///< Prefer the slowest region; overflow towards the faster ones (e.g. bulk buffers).
+} O1HeapMultiHint;
+
+/// o1heapInitMulti() will fail unless the first region is at least this large.
+/// The multi-arena bookkeeping structure is carved from the first region, hence the extra overhead over
+/// o1heapMinArenaSize.
+size_t o1heapMultiMinArenaSize(void);
+
+/// Initializes a multi-arena heap over its first (fastest) memory region. Further regions are registered with
+/// o1heapMultiAddArena(). The base pointer shall be aligned at O1HEAP_ALIGNMENT, otherwise NULL is returned.
+///
+/// The function fails and returns NULL iff:
+/// - The provided space is less than o1heapMultiMinArenaSize().
+/// - The base pointer is not aligned at O1HEAP_ALIGNMENT.
+/// - The base pointer is NULL.
+///
+/// The multi-arena layer itself performs no locking; the heap is not thread-safe.
+O1HeapMultiInstance* o1heapInitMulti(void* const base, const size_t size);
+
+/// Registers an additional (slower) memory region with the heap. The regions shall not overlap.
+/// The base pointer shall be aligned at O1HEAP_ALIGNMENT and the size shall be at least o1heapMinArenaSize.
+/// Returns falsity iff the arguments are invalid or the compile-time region limit is reached
+/// (see O1HEAP_MULTI_MAX_ARENAS in o1heap_multi.c).
+bool o1heapMultiAddArena(O1HeapMultiInstance* const handle, void* const base, const size_t size);
+
+/// Same as o1heapMultiAllocateHinted() with O1HeapMultiHintFast.
+void* o1heapMultiAllocate(O1HeapMultiInstance* const handle, const size_t amount);
+
+/// Allocates amount bytes, trying the registered regions in the order implied by the hint and returning the
+/// first success; NULL is returned only if no region can serve the request. The semantics otherwise follow
+/// o1heapAllocate(). The time complexity is linear of the number of regions in the worst case, which is a small
+/// compile-time-bounded constant, and constant when the preferred region can serve the request.
+void* o1heapMultiAllocateHinted(O1HeapMultiInstance* const handle, const size_t amount, const O1HeapMultiHint hint);
+
+/// Returns the fragment to the region that owns it, which is identified from the pointer value.
+/// The pointer shall have been returned by an allocation function of the same multi-arena instance;
+/// NULL is a no-op. The time complexity is linear of the number of regions (a small bounded constant).
+void o1heapMultiFree(O1HeapMultiInstance* const handle, void* const pointer);
+
+/// Returns the number of registered regions, which is at least 1.
+size_t o1heapMultiGetArenaCount(const O1HeapMultiInstance* const handle);
+
+/// Returns the underlying heap instance of the specified region (0 is the fastest), or NULL if out of range.
+/// This is intended for per-region diagnostics and invariant checking via the core API.
+O1HeapInstance* o1heapMultiGetArena(const O1HeapMultiInstance* const handle, const size_t index);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // O1HEAP_MULTI_H_INCLUDED
@@ -0,0 +1,128 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+#include "o1heap_sharded.h"
+#include <assert.h>
+
+/// Define this macro to include build configuration header. This is an alternative to the -D compiler flag.
+#ifdef O1HEAP_CONFIG_HEADER
+#    include O1HEAP_CONFIG_HEADER
+#endif
+
+/// The assertion macro defaults to the standard assert(), same as in the core library.
+#ifndef O1HEAP_ASSERT
+// Intentional violation of MISRA: the assertion check macro cannot be replaced with a function definition.
+#    define O1HEAP_ASSERT(x) assert(x)  // NOSONAR
+#endif
+
+/// The hard upper limit on the number of shards. It bounds the size of the sharded instance structure and the
+/// worst-case execution time of the overflow path. One shard per core is the intended use, so the default is
+/// generous; it can be overridden via O1HEAP_CONFIG_HEADER if needed.
+#ifndef O1HEAP_SHARDED_MAX_SHARDS
+#    define O1HEAP_SHARDED_MAX_SHARDS 16U
+#endif
+
+struct O1HeapShardedInstance
+{
+    O1HeapInstance* shards[O1HEAP_SHARDED_MAX_SHARDS];
+    size_t          num_shards;
+    char*           shards_base;   ///< Base address of the first shard sub-arena.
+    size_t          shard_stride;  ///< Distance between the bases of adjacent shard sub-arenas.
+};
+
+/// Same padding policy as for the core instance: keeps the first shard sub-arena aligned at O1HEAP_ALIGNMENT.
+#define SHARDED_INSTANCE_SIZE_PADDED \
+    ((sizeof(O1HeapShardedInstance) + O1HEAP_ALIGNMENT - 1U) & ~(O1HEAP_ALIGNMENT - 1U))
+
+size_t o1heapShardedMinArenaSize(const size_t num_shards)
+{
+    size_t out = 0U;
+    if ((num_shards > 0U) && (num_shards <= O1HEAP_SHARDED_MAX_SHARDS))
+    {
+        // Each shard stride must be a multiple of O1HEAP_ALIGNMENT and hold at least a minimal core arena.
+        const size_t stride = (o1heapMinArenaSize + O1HEAP_ALIGNMENT - 1U) & ~(O1HEAP_ALIGNMENT - 1U);
+        out                 = SHARDED_INSTANCE_SIZE_PADDED + (stride * num_shards);
+    }
+    return out;
+}
+
+O1HeapShardedInstance* o1heapInitSharded(void* const base, const size_t size, const size_t num_shards)
+{
+    O1HeapShardedInstance* out      = NULL;
+    const size_t           min_size = o1heapShardedMinArenaSize(num_shards);
+    if ((base != NULL) && ((((size_t) base) % O1HEAP_ALIGNMENT) == 0U) && (min_size > 0U) && (size >= min_size))
+    {
+        out              = (O1HeapShardedInstance*) base;
+        out->num_shards  = num_shards;
+        out->shards_base = ((char*) base) + SHARDED_INSTANCE_SIZE_PADDED;
+        // Divide the remaining space equally; the stride shall keep every shard base aligned.
+        const size_t space = size - SHARDED_INSTANCE_SIZE_PADDED;
+        out->shard_stride  = (space / num_shards) & ~(O1HEAP_ALIGNMENT - 1U);
+        O1HEAP_ASSERT(out->shard_stride >= o1heapMinArenaSize);
+        for (size_t i = 0U; i < num_shards; i++)
+        {
+            out->shards[i] = o1heapInit(out->shards_base + (i * out->shard_stride), out->shard_stride);
+            O1HEAP_ASSERT(out->shards[i] != NULL);  // Cannot fail: the base is aligned and the stride is sufficient.
+        }
+        for (size_t i = num_shards; i < O1HEAP_SHARDED_MAX_SHARDS; i++)
+        {
+            out->shards[i] = NULL;
+        }
+    }
+    return out;
+}
+
+void* o1heapShardedAllocate(O1HeapShardedInstance* const handle, const size_t shard_index, const size_t amount)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    O1HEAP_ASSERT(shard_index < handle->num_shards);
+    // The local shard is tried first; on failure the neighbors are tried in round-robin order, turning the hard
+    // per-shard capacity limit into a soft one. The loop is bounded by the number of shards, which is a small
+    // compile-time-bounded constant, so the worst case remains constant for a given configuration.
+    void* out = NULL;
+    for (size_t i = 0U; (i < handle->num_shards) && (out == NULL); i++)
+    {
+        const size_t idx = (shard_index + i) % handle->num_shards;
+        out              = o1heapAllocate(handle->shards[idx], amount);
+    }
+    return out;
+}
+
+void o1heapShardedFree(O1HeapShardedInstance* const handle, void* const pointer)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    if (pointer != NULL)  // NULL pointer is a no-op.
+    {
+        // Route the fragment back to its owning shard, which is identified from the address in constant time.
+        O1HEAP_ASSERT(((char*) pointer) > handle->shards_base);
+        const size_t offset = (size_t) (((char*) pointer) - handle->shards_base);
+        const size_t idx    = offset / handle->shard_stride;
+        O1HEAP_ASSERT(idx < handle->num_shards);
+        o1heapFree(handle->shards[idx], pointer);
+    }
+}
+
+size_t o1heapShardedGetNumShards(const O1HeapShardedInstance* const handle)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    return handle->num_shards;
+}
+
+O1HeapInstance* o1heapShardedGetShard(const O1HeapShardedInstance* const handle, const size_t shard_index)
+{
+    O1HEAP_ASSERT(handle != NULL);
+    return (shard_index < handle->num_shards) ? handle->shards[shard_index] : NULL;
+}
@@ -0,0 +1,78 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+//
+// This is an optional companion module implemented on top of the core library (o1heap.c/o1heap.h).
+// It is intended for multi-core systems where running one O1HeapInstance per core loses memory to static
+// partitioning: a sharded heap builds one sub-heap per core over a single shared arena, and a shard that runs
+// out of memory overflows into its neighbors instead of failing. Applications that do not need sharding
+// should not compile this module.
+
+#ifndef O1HEAP_SHARDED_H_INCLUDED
+#define O1HEAP_SHARDED_H_INCLUDED
+
+#include "o1heap.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The definition is private, so the user code can only operate on pointers. This is done to enforce encapsulation.
+typedef struct O1HeapShardedInstance O1HeapShardedInstance;
+
+/// o1heapInitSharded() will fail unless the arena size is at least this large for the given number of shards.
+/// The number of shards shall be positive and not exceed the compile-time limit (see o1heap_sharded.c).
+size_t o1heapShardedMinArenaSize(const size_t num_shards);
+
+/// Builds num_shards independent sub-heaps over one arena; each shard is a regular O1HeapInstance,
+/// so all per-shard guarantees of the core library (constant-time operation, bounded fragmentation) hold.
+/// The arena base pointer shall be aligned at O1HEAP_ALIGNMENT, otherwise NULL is returned.
+///
+/// The function fails and returns NULL iff:
+/// - The provided space is less than o1heapShardedMinArenaSize(num_shards).
+/// - The base pointer is not aligned at O1HEAP_ALIGNMENT.
+/// - The base pointer is NULL.
+/// - num_shards is zero or exceeds the compile-time limit.
+///
+/// The sharded layer itself performs no locking. Concurrent use of distinct shards from distinct cores is safe
+/// without synchronization ONLY if allocation requests never overflow into a neighboring shard and all frees are
+/// routed back to the allocating core. If overflow may occur (which is the point of this module), each underlying
+/// shard instance shall be protected by its own (short) critical section supplied by the application.
+O1HeapShardedInstance* o1heapInitSharded(void* const base, const size_t size, const size_t num_shards);
+
+/// Allocates from the specified shard; if the shard cannot serve the request, the other shards are tried in
+/// round-robin order before giving up. The shard index shall be less than the number of shards.
+/// The semantics otherwise follow o1heapAllocate(). The time complexity is linear of the number of shards in the
+/// worst case (constant for a fixed shard count), and constant when the local shard can serve the request.
+void* o1heapShardedAllocate(O1HeapShardedInstance* const handle, const size_t shard_index, const size_t amount);
+
+/// Returns the fragment to the shard that owns it, which is determined from the pointer value in constant time.
+/// The pointer shall have been returned by o1heapShardedAllocate() on the same sharded instance; NULL is a no-op.
+void o1heapShardedFree(O1HeapShardedInstance* const handle, void* const pointer);
+
+/// Returns the number of shards the instance was initialized with.
+size_t o1heapShardedGetNumShards(const O1HeapShardedInstance* const handle);
+
+/// Returns the underlying heap instance of the specified shard, or NULL if the index is out of range.
+/// This is intended for per-shard diagnostics and invariant checking via the core API.
+O1HeapInstance* o1heapShardedGetShard(const O1HeapShardedInstance* const handle, const size_t shard_index);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // O1HEAP_SHARDED_H_INCLUDED
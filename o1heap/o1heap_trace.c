@@ -0,0 +1,80 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+#include "o1heap_trace.h"
+#include <assert.h>
+
+/// Define this macro to include build configuration header. This is an alternative to the -D compiler flag.
+#ifdef O1HEAP_CONFIG_HEADER
+#    include O1HEAP_CONFIG_HEADER
+#endif
+
+/// The assertion macro defaults to the standard assert(), same as in the core library.
+#ifndef O1HEAP_ASSERT
+// Intentional violation of MISRA: the assertion check macro cannot be replaced with a function definition.
+#    define O1HEAP_ASSERT(x) assert(x)  // NOSONAR
+#endif
+
+void o1heapTraceRecorderInit(O1HeapTraceRecorder* const         self,
+                             O1HeapTraceRecord* const           buffer,
+                             const size_t                       capacity,
+                             const O1HeapTraceTimestampFunction now)
+{
+    O1HEAP_ASSERT(self != NULL);
+    O1HEAP_ASSERT(buffer != NULL);
+    O1HEAP_ASSERT(capacity > 0U);
+    self->buffer   = buffer;
+    self->capacity = capacity;
+    self->head     = 0U;
+    self->total    = 0U;
+    self->now      = now;
+}
+
+void o1heapTraceRecord(O1HeapTraceRecorder* const self,
+                       const uint8_t              event,
+                       const void* const          pointer,
+                       const size_t               size)
+{
+    O1HEAP_ASSERT(self != NULL);
+    O1HEAP_ASSERT(self->buffer != NULL);
+    O1HEAP_ASSERT(self->head < self->capacity);
+    O1HeapTraceRecord* const rec = &self->buffer[self->head];
+    rec->timestamp               = (self->now != NULL) ? self->now() : self->total;
+    rec->pointer                 = (uintptr_t) pointer;
+    rec->size                    = size;
+    rec->event                   = event;
+    self->head                   = (self->head + 1U) % self->capacity;
+    self->total++;
+}
+
+size_t o1heapTraceGetCount(const O1HeapTraceRecorder* const self)
+{
+    O1HEAP_ASSERT(self != NULL);
+    return (self->total < self->capacity) ? ((size_t) self->total) : self->capacity;
+}
+
+const O1HeapTraceRecord* o1heapTraceGetRecord(const O1HeapTraceRecorder* const self, const size_t index)
+{
+    O1HEAP_ASSERT(self != NULL);
+    const O1HeapTraceRecord* out = NULL;
+    if (index < o1heapTraceGetCount(self))
+    {
+        // If the buffer has wrapped, the oldest retained record is the one about to be overwritten next.
+        const size_t oldest = (self->total <= self->capacity) ? 0U : self->head;
+        out                 = &self->buffer[(oldest + index) % self->capacity];
+    }
+    return out;
+}
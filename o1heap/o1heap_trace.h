@@ -0,0 +1,87 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+//
+// This is an optional companion module implemented on top of the core library (o1heap.c/o1heap.h).
+// It provides a reference event recorder for the O1HEAP_TRACE_HOOK() profiling macro of the core library:
+// events are timestamped and stored into a caller-provided ring buffer with no allocation and no locking,
+// so the recorder is usable from the allocation hot paths of a hard real-time system. The recorded trace can be
+// streamed to a host and replayed offline (e.g. through the test simulator) to evaluate tuning changes without
+// experimenting on live devices. Applications that do not profile the heap should not compile this module.
+
+#ifndef O1HEAP_TRACE_H_INCLUDED
+#define O1HEAP_TRACE_H_INCLUDED
+
+#include "o1heap.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// One recorded heap event. The layout is fixed and free of pointers so that traces can be stored or
+/// transferred verbatim; see the O1HEAP_TRACE_EVENT_* identifiers in o1heap.h for the field semantics.
+typedef struct
+{
+    uint64_t  timestamp;  ///< Sampled from the user-provided time source; a monotonic sequence number if none.
+    uintptr_t pointer;    ///< The user pointer of the affected fragment; zero for a failed allocation.
+    size_t    size;       ///< The requested amount, or the payload capacity for free events.
+    uint8_t   event;      ///< One of the O1HEAP_TRACE_EVENT_* identifiers.
+} O1HeapTraceRecord;
+
+/// The user-provided time source; e.g. a cycle counter or a monotonic clock. Invoked once per recorded event.
+typedef uint64_t (*O1HeapTraceTimestampFunction)(void);
+
+/// The recorder state. Unlike the core heap instance, the definition is public because the storage is
+/// caller-provided and the recorded events are meant to be read out directly; treat the fields as read-only.
+/// The recorder performs no locking: it shall only be used from the context that owns the heap, which is the
+/// same restriction the core library imposes anyway.
+typedef struct
+{
+    O1HeapTraceRecord*           buffer;    ///< Caller-provided storage; the oldest record is overwritten on wrap.
+    size_t                       capacity;  ///< The number of records the buffer can hold.
+    size_t                       head;      ///< The index of the next record to be written.
+    uint64_t                     total;     ///< Total events ever recorded, including the overwritten ones.
+    O1HeapTraceTimestampFunction now;       ///< May be NULL, in which case `total` doubles as the timestamp.
+} O1HeapTraceRecorder;
+
+/// Binds the recorder to a caller-provided buffer of the given capacity (in records) and resets its state.
+/// The timestamp function may be NULL, in which case the events are stamped with a monotonic sequence number.
+/// The buffer shall not be NULL and the capacity shall be positive; this is asserted, not checked at runtime.
+void o1heapTraceRecorderInit(O1HeapTraceRecorder* const         self,
+                             O1HeapTraceRecord* const           buffer,
+                             const size_t                       capacity,
+                             const O1HeapTraceTimestampFunction now);
+
+/// Appends one event to the ring buffer, overwriting the oldest record if full. Constant time, no allocation.
+/// This is the intended expansion target of O1HEAP_TRACE_HOOK(); the heap instance argument of the hook is not
+/// needed here and can be discarded by the macro definition, e.g.:
+///     #define O1HEAP_TRACE_HOOK(handle, event, pointer, size) o1heapTraceRecord(&my_recorder, event, pointer, size)
+void o1heapTraceRecord(O1HeapTraceRecorder* const self,
+                       const uint8_t              event,
+                       const void* const          pointer,
+                       const size_t               size);
+
+/// Returns the number of records currently retained in the buffer, which is at most its capacity.
+size_t o1heapTraceGetCount(const O1HeapTraceRecorder* const self);
+
+/// Returns the retained record at the given index, where zero is the oldest; NULL if the index is out of range.
+const O1HeapTraceRecord* o1heapTraceGetRecord(const O1HeapTraceRecorder* const self, const size_t index);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // O1HEAP_TRACE_H_INCLUDED
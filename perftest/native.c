@@ -0,0 +1,489 @@
+// Copyright (c) Pavel Kirienko
+//
+// Host-native variant of the perftest for x86-64 and AArch64 servers; see main.c for the RP2040/RP2350 original.
+// It reuses the same Allocator abstraction and the same mixed-lifetime workload (random batch allocation with
+// shuffled partial frees over at most MAX_LIVE_BLOCKS live blocks), but times each operation with the best
+// available host clock and emits machine-readable CSV with per-operation latency percentiles so that CI can
+// gate on the worst-case allocation latency. Build via the top-level CMakeLists.txt (target perftest_native).
+
+#include "o1heap.h"
+
+#include <inttypes.h>
+#include <stdalign.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifndef HEAP_ARENA_SIZE_BYTES
+#    define HEAP_ARENA_SIZE_BYTES (64u * 1024u)
+#endif
+#ifndef MEASURE_ITERATIONS
+#    define MEASURE_ITERATIONS 2000000u
+#endif
+#define MAX_LIVE_BLOCKS 256u
+
+/// Latencies are histogrammed with unit resolution up to this bound; greater values land in the last bucket.
+#define HIST_BUCKETS 65536u
+
+// ==================== Timing ====================
+
+/// Returns an opaque monotonic timestamp; only differences are meaningful. The unit is reported by tic_units().
+static inline uint64_t tic(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    uint32_t lo;
+    uint32_t hi;
+    __asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
+    return (((uint64_t) hi) << 32u) | lo;
+#elif defined(__aarch64__)
+    uint64_t out;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(out));
+    return out;
+#else
+    struct timespec ts;
+    (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (((uint64_t) ts.tv_sec) * 1000000000u) + (uint64_t) ts.tv_nsec;
+#endif
+}
+
+static inline const char* tic_units(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return "tsc";
+#elif defined(__aarch64__)
+    return "cntvct";
+#else
+    return "ns";
+#endif
+}
+
+// ==================== Allocator abstraction ====================
+
+typedef void* (*AllocFunc)(void* ctx, size_t size);
+typedef void (*FreeFunc)(void* ctx, void* ptr);
+
+typedef struct
+{
+    const char* name;
+    void*       ctx;
+    AllocFunc   alloc;
+    FreeFunc    free;
+    bool        has_diagnostics;
+} Allocator;
+
+static alignas(O1HEAP_ALIGNMENT) uint8_t heap_arena[HEAP_ARENA_SIZE_BYTES];
+
+// ==================== o1heap wrapper ====================
+
+static void* o1heap_alloc_wrapper(void* ctx, size_t size)
+{
+    return o1heapAllocate((O1HeapInstance*) ctx, size);
+}
+
+static void o1heap_free_wrapper(void* ctx, void* ptr)
+{
+    o1heapFree((O1HeapInstance*) ctx, ptr);
+}
+
+// ==================== Native malloc wrapper ====================
+
+static void* malloc_alloc_wrapper(void* ctx, size_t size)
+{
+    (void) ctx;
+    return malloc(size);
+}
+
+static void malloc_free_wrapper(void* ctx, void* ptr)
+{
+    (void) ctx;
+    free(ptr);
+}
+
+// ==================== No-op for overhead measurement ====================
+
+static void* noop_alloc(void* ctx, size_t size)
+{
+    (void) ctx;
+    return (void*) (uintptr_t) size;  // Prevent optimization; return non-NULL
+}
+
+static void noop_free(void* ctx, void* ptr)
+{
+    (void) ctx;
+    (void) ptr;
+}
+
+// ==================== Test data ====================
+
+static const uint16_t alloc_sizes[] = {
+    16u,
+    32u,
+    64u,
+    128u,
+    256u,
+    512u,
+    1024u,  // More sizes for varied fragmentation
+};
+
+#define ALLOC_SIZES_COUNT (sizeof(alloc_sizes) / sizeof(alloc_sizes[0]))
+
+static void*    live_blocks[MAX_LIVE_BLOCKS];
+static uint32_t live_block_size_idx[MAX_LIVE_BLOCKS];  // Track size index for each live block
+static uint32_t free_order[MAX_LIVE_BLOCKS];           // Shuffled indices for random free order
+static uint32_t rng_state = 0x9e3779b9u;
+
+typedef struct
+{
+    uint64_t min;
+    uint64_t max;
+    uint64_t sum;
+    uint64_t count;
+    uint32_t hist[HIST_BUCKETS];  // Unit-resolution latency histogram; the last bucket collects the overflow.
+} Stats;
+
+// One instance per operation kind and per size class, plus one aggregate per operation kind.
+static Stats alloc_stats[ALLOC_SIZES_COUNT];
+static Stats free_stats[ALLOC_SIZES_COUNT];
+static Stats alloc_total;
+static Stats free_total;
+
+static void stats_init(Stats* s)
+{
+    s->min   = UINT64_MAX;
+    s->max   = 0u;
+    s->sum   = 0u;
+    s->count = 0u;
+    for (size_t i = 0; i < HIST_BUCKETS; i++)
+    {
+        s->hist[i] = 0u;
+    }
+}
+
+static void stats_add(Stats* s, uint64_t v)
+{
+    if (v < s->min)
+    {
+        s->min = v;
+    }
+    if (v > s->max)
+    {
+        s->max = v;
+    }
+    s->sum += v;
+    s->count++;
+    const size_t bucket = (v < HIST_BUCKETS) ? (size_t) v : (size_t) (HIST_BUCKETS - 1u);
+    s->hist[bucket]++;
+}
+
+static uint64_t stats_mean(const Stats* s)
+{
+    return (s->count == 0u) ? 0u : (s->sum / s->count);
+}
+
+/// Returns the q-th per-mille latency (e.g., 500 is the median, 999 is p99.9) from the histogram.
+/// Values beyond the histogram range are indistinguishable from its upper bound.
+static uint64_t stats_percentile(const Stats* s, uint32_t q_permille)
+{
+    if (s->count == 0u)
+    {
+        return 0u;
+    }
+    const uint64_t rank = ((s->count * q_permille) + 999u) / 1000u;
+    uint64_t       seen = 0u;
+    for (size_t i = 0; i < HIST_BUCKETS; i++)
+    {
+        seen += s->hist[i];
+        if (seen >= rank)
+        {
+            return (uint64_t) i;
+        }
+    }
+    return (uint64_t) (HIST_BUCKETS - 1u);
+}
+
+static uint64_t measure_cycle_overhead(uint32_t samples)
+{
+    // Use function pointers to match the indirection overhead in actual measurements.
+    volatile AllocFunc alloc_fn = noop_alloc;
+    volatile FreeFunc  free_fn  = noop_free;
+    void* volatile ctx          = NULL;
+
+    uint64_t alloc_min = UINT64_MAX;
+    uint64_t free_min  = UINT64_MAX;
+    if (samples == 0u)
+    {
+        samples = 1u;
+    }
+    for (uint32_t i = 0; i < samples; i++)
+    {
+        const uint64_t alloc_start = tic();
+        void* const    p           = alloc_fn(ctx, 64u);
+        const uint64_t alloc_end   = tic();
+
+        const uint64_t free_start = tic();
+        free_fn(ctx, p);
+        const uint64_t free_end = tic();
+
+        const uint64_t alloc_delta = alloc_end - alloc_start;
+        const uint64_t free_delta  = free_end - free_start;
+        if (alloc_delta < alloc_min)
+        {
+            alloc_min = alloc_delta;
+        }
+        if (free_delta < free_min)
+        {
+            free_min = free_delta;
+        }
+    }
+    // Return the larger of the two for a conservative estimate.
+    return (alloc_min > free_min) ? alloc_min : free_min;
+}
+
+static void print_csv_header(void)
+{
+    printf("allocator,op,bytes,count,min,mean,p50,p90,p99,p999,max\n");
+}
+
+static void print_csv_row(const char* allocator, const char* op, const char* bytes, const Stats* s)
+{
+    printf("%s,%s,%s,%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64
+           "\n",
+           allocator,
+           op,
+           bytes,
+           s->count,
+           (s->count > 0u) ? s->min : 0u,
+           stats_mean(s),
+           stats_percentile(s, 500u),
+           stats_percentile(s, 900u),
+           stats_percentile(s, 990u),
+           stats_percentile(s, 999u),
+           s->max);
+}
+
+static uint32_t rand_u32(void)
+{
+    rng_state = (rng_state * 1664525u) + 1013904223u;
+    return rng_state;
+}
+
+static size_t random_size_index(void)
+{
+    return (size_t) (rand_u32() % ALLOC_SIZES_COUNT);
+}
+
+/// Fisher-Yates shuffle for randomizing free order.
+static void shuffle_indices(uint32_t* arr, uint32_t n)
+{
+    for (uint32_t i = n - 1; i > 0; i--)
+    {
+        const uint32_t j   = rand_u32() % (i + 1);
+        const uint32_t tmp = arr[i];
+        arr[i]             = arr[j];
+        arr[j]             = tmp;
+    }
+}
+
+static void run_perftest(const Allocator* allocator)
+{
+    rng_state = 0x9e3779b9u;  // Reset RNG for reproducible results each run
+
+    stats_init(&alloc_total);
+    stats_init(&free_total);
+    for (size_t i = 0; i < ALLOC_SIZES_COUNT; i++)
+    {
+        stats_init(&alloc_stats[i]);
+        stats_init(&free_stats[i]);
+    }
+
+    const uint64_t overhead = measure_cycle_overhead(64u);
+
+    // Batch allocations and frees with randomized patterns to explore heap states.
+    // - Random batch sizes (32 to MAX_LIVE_BLOCKS)
+    // - Random free order (shuffled)
+    // - Partial frees (keep 0-25% of blocks sometimes)
+    uint32_t total_allocs = 0;
+    uint32_t total_frees  = 0;
+    uint32_t num_live     = 0;  // Currently allocated blocks
+
+    while (total_allocs < MEASURE_ITERATIONS || total_frees < MEASURE_ITERATIONS)
+    {
+        // Decide batch size: random between 32 and remaining capacity
+        const uint32_t capacity = MAX_LIVE_BLOCKS - num_live;
+        if (capacity == 0)
+        {
+            goto free_phase;  // Must free some blocks first
+        }
+        const uint32_t min_batch  = (capacity < 32u) ? capacity : 32u;
+        const uint32_t batch_size = min_batch + (rand_u32() % (capacity - min_batch + 1u));
+
+        // Allocation phase
+        for (uint32_t i = 0; i < batch_size; i++)
+        {
+            const uint32_t size_index = (uint32_t) random_size_index();
+            const size_t   alloc_size = alloc_sizes[size_index];
+
+            const uint64_t alloc_start = tic();
+            void* const    p           = allocator->alloc(allocator->ctx, alloc_size);
+            const uint64_t alloc_end   = tic();
+
+            if (p == NULL)
+            {
+                break;  // Heap full
+            }
+
+            live_blocks[num_live]         = p;
+            live_block_size_idx[num_live] = size_index;
+            num_live++;
+
+            if (total_allocs < MEASURE_ITERATIONS)
+            {
+                const uint64_t alloc_cycles = alloc_end - alloc_start;
+                const uint64_t alloc_adj    = (alloc_cycles > overhead) ? (alloc_cycles - overhead) : 0u;
+                stats_add(&alloc_stats[size_index], alloc_adj);
+                stats_add(&alloc_total, alloc_adj);
+                total_allocs++;
+            }
+        }
+
+    free_phase:;
+        // Decide how many to free: sometimes keep 0-25% allocated
+        const uint32_t keep_count  = (rand_u32() % 4u == 0u) ? (rand_u32() % (num_live / 4u + 1u)) : 0u;
+        const uint32_t num_to_free = num_live - keep_count;
+        if (num_to_free == 0)
+        {
+            continue;
+        }
+
+        // Build shuffled free order
+        for (uint32_t i = 0; i < num_live; i++)
+        {
+            free_order[i] = i;
+        }
+        shuffle_indices(free_order, num_live);
+
+        // Free phase: free in random order
+        uint32_t freed = 0;
+        for (uint32_t i = 0; i < num_live && freed < num_to_free; i++)
+        {
+            const uint32_t idx = free_order[i];
+            if (live_blocks[idx] == NULL)
+            {
+                continue;  // Already freed
+            }
+
+            const uint32_t size_index = live_block_size_idx[idx];
+
+            const uint64_t free_start = tic();
+            allocator->free(allocator->ctx, live_blocks[idx]);
+            const uint64_t free_end = tic();
+
+            live_blocks[idx] = NULL;
+            freed++;
+
+            if (total_frees < MEASURE_ITERATIONS)
+            {
+                const uint64_t free_cycles = free_end - free_start;
+                const uint64_t free_adj    = (free_cycles > overhead) ? (free_cycles - overhead) : 0u;
+                stats_add(&free_stats[size_index], free_adj);
+                stats_add(&free_total, free_adj);
+                total_frees++;
+            }
+        }
+
+        // Compact live_blocks array (remove NULLs)
+        uint32_t write_idx = 0;
+        for (uint32_t read_idx = 0; read_idx < num_live; read_idx++)
+        {
+            if (live_blocks[read_idx] != NULL)
+            {
+                if (write_idx != read_idx)
+                {
+                    live_blocks[write_idx]         = live_blocks[read_idx];
+                    live_block_size_idx[write_idx] = live_block_size_idx[read_idx];
+                }
+                write_idx++;
+            }
+        }
+        num_live = write_idx;
+    }
+
+    // Drain whatever is still live so consecutive runs start from an empty heap.
+    for (uint32_t i = 0; i < num_live; i++)
+    {
+        allocator->free(allocator->ctx, live_blocks[i]);
+        live_blocks[i] = NULL;
+    }
+    num_live = 0;
+
+    if (allocator->has_diagnostics)
+    {
+        const O1HeapDiagnostics diag = o1heapGetDiagnostics((O1HeapInstance*) allocator->ctx);
+        fprintf(stderr,
+                "# %s: capacity=%llu allocated=%llu peak=%llu peak_req=%llu oom=%llu overhead=%" PRIu64 "\n",
+                allocator->name,
+                (unsigned long long) diag.capacity,
+                (unsigned long long) diag.allocated,
+                (unsigned long long) diag.peak_allocated,
+                (unsigned long long) diag.peak_request_size,
+                (unsigned long long) diag.oom_count,
+                overhead);
+    }
+    else
+    {
+        fprintf(stderr, "# %s: overhead=%" PRIu64 "\n", allocator->name, overhead);
+    }
+
+    char bytes_text[8];
+    print_csv_row(allocator->name, "alloc", "total", &alloc_total);
+    print_csv_row(allocator->name, "free", "total", &free_total);
+    for (size_t i = 0; i < ALLOC_SIZES_COUNT; i++)
+    {
+        (void) snprintf(bytes_text, sizeof(bytes_text), "%u", (unsigned) alloc_sizes[i]);
+        print_csv_row(allocator->name, "alloc", bytes_text, &alloc_stats[i]);
+        print_csv_row(allocator->name, "free", bytes_text, &free_stats[i]);
+    }
+}
+
+int main(void)
+{
+    fprintf(stderr,
+            "# o1heap native perftest: units=%s, heap=%u bytes, iterations=%u, max_live=%u\n",
+            tic_units(),
+            (unsigned) sizeof(heap_arena),
+            (unsigned) MEASURE_ITERATIONS,
+            (unsigned) MAX_LIVE_BLOCKS);
+
+    O1HeapInstance* const o1heap = o1heapInit(heap_arena, sizeof(heap_arena));
+    if (o1heap == NULL)
+    {
+        fprintf(stderr,
+                "o1heapInit failed (arena size=%u, min=%u)\n",
+                (unsigned) sizeof(heap_arena),
+                (unsigned) o1heapMinArenaSize);
+        return EXIT_FAILURE;
+    }
+
+    const Allocator o1heap_allocator = {
+        .name            = "o1heap",
+        .ctx             = o1heap,
+        .alloc           = o1heap_alloc_wrapper,
+        .free            = o1heap_free_wrapper,
+        .has_diagnostics = true,
+    };
+
+    const Allocator malloc_allocator = {
+        .name            = "malloc",
+        .ctx             = NULL,
+        .alloc           = malloc_alloc_wrapper,
+        .free            = malloc_free_wrapper,
+        .has_diagnostics = false,
+    };
+
+    print_csv_header();
+    run_perftest(&o1heap_allocator);
+    run_perftest(&malloc_allocator);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,484 @@
+// Copyright (c) Pavel Kirienko
+//
+// WCET characterization harness: unlike the perftest, which reports the latency distribution of whatever workload
+// mix it happens to generate, this program deliberately constructs the worst-case heap state for each branch of
+// the public API -- the deepest split in o1heapAllocate(), the triple merge in o1heapFree(), and every path of
+// o1heapReallocate() including the memmove case at the maximum fragment size -- and reports per-branch cycle
+// counts using the same Stats min/max machinery. The numbers are intended to feed schedulability analysis:
+// rerun this for every release instead of re-measuring the worst case by hand.
+//
+// The same source builds for the host (see the top-level CMakeLists.txt, target perftest_wcet; timed with rdtsc
+// on x86, cntvct_el0 on AArch64, or clock_gettime elsewhere) and for the RP2350 via perftest/CMakeLists.txt
+// (target o1heap_wcet; timed with the DWT cycle counter, results printed over UART0 like the perftest).
+// Each scenario is rebuilt from a freshly initialized heap on every iteration, so the measured operation always
+// runs on the exact intended fragment layout; construction and verification are excluded from the timing.
+
+#include "o1heap.h"
+
+#ifdef PICO_BUILD
+#    include "pico/stdlib.h"
+#    include "pico/stdio_uart.h"
+#    include "hardware/clocks.h"
+#    include "hardware/sync.h"
+#else
+#    include <time.h>
+#endif
+
+#include <inttypes.h>
+#include <stdalign.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef HEAP_ARENA_SIZE_BYTES
+#    define HEAP_ARENA_SIZE_BYTES (64u * 1024u)
+#endif
+#ifndef WCET_ITERATIONS
+#    define WCET_ITERATIONS 4096u
+#endif
+
+/// The minimum fragment size; all scenario layouts are expressed in multiples of this unit so that the harness
+/// constructs the same fragment topology on 32-bit and 64-bit targets alike.
+#define U (O1HEAP_ALIGNMENT * 2u)
+
+/// Payload amount whose fragment is exactly the given (power-of-2) fragment size.
+#define AMOUNT(frag_size) ((frag_size) -O1HEAP_ALIGNMENT)
+
+// ==================== Timing ====================
+
+#ifdef PICO_BUILD
+
+#    define DEMCR_ADDR (0xE000EDFCu)
+#    define DWT_CTRL_ADDR (0xE0001000u)
+#    define DWT_CYCCNT_ADDR (0xE0001004u)
+#    define DEMCR_TRCENA_BIT (1u << 24)
+#    define DWT_CTRL_CYCCNT (1u << 0)
+
+static inline void cycle_counter_init(void)
+{
+    *(volatile uint32_t*) DEMCR_ADDR |= DEMCR_TRCENA_BIT;
+    *(volatile uint32_t*) DWT_CYCCNT_ADDR = 0u;
+    *(volatile uint32_t*) DWT_CTRL_ADDR |= DWT_CTRL_CYCCNT;
+}
+
+static inline uint64_t tic(void)
+{
+    return *(volatile uint32_t*) DWT_CYCCNT_ADDR;
+}
+
+static inline const char* tic_units(void)
+{
+    return "cycles";
+}
+
+#else
+
+/// Returns an opaque monotonic timestamp; only differences are meaningful. The unit is reported by tic_units().
+static inline uint64_t tic(void)
+{
+#    if defined(__x86_64__) || defined(__i386__)
+    uint32_t lo;
+    uint32_t hi;
+    __asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
+    return (((uint64_t) hi) << 32u) | lo;
+#    elif defined(__aarch64__)
+    uint64_t out;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(out));
+    return out;
+#    else
+    struct timespec ts;
+    (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (((uint64_t) ts.tv_sec) * 1000000000u) + (uint64_t) ts.tv_nsec;
+#    endif
+}
+
+static inline const char* tic_units(void)
+{
+#    if defined(__x86_64__) || defined(__i386__)
+    return "tsc";
+#    elif defined(__aarch64__)
+    return "cntvct";
+#    else
+    return "ns";
+#    endif
+}
+
+#endif
+
+// ==================== Stats ====================
+
+typedef struct
+{
+    uint64_t min;
+    uint64_t max;
+    uint64_t sum;
+} Stats;
+
+static inline void stats_init(Stats* s)
+{
+    s->min = UINT64_MAX;
+    s->max = 0u;
+    s->sum = 0u;
+}
+
+static inline void stats_add(Stats* s, uint64_t v)
+{
+    if (v < s->min)
+    {
+        s->min = v;
+    }
+    if (v > s->max)
+    {
+        s->max = v;
+    }
+    s->sum += v;
+}
+
+static inline uint64_t stats_mean(const Stats* s, uint32_t n)
+{
+    return (n == 0u) ? 0u : (s->sum / n);
+}
+
+/// The minimum latency of two back-to-back timestamp reads; subtracted from every measurement.
+static uint64_t measure_overhead(void)
+{
+    uint64_t best = UINT64_MAX;
+    for (uint32_t i = 0; i < 1024u; i++)
+    {
+        const uint64_t a = tic();
+        const uint64_t b = tic();
+        const uint64_t d = b - a;
+        if (d < best)
+        {
+            best = d;
+        }
+    }
+    return best;
+}
+
+// ==================== Scenario machinery ====================
+
+static alignas(O1HEAP_ALIGNMENT) uint8_t heap_arena[HEAP_ARENA_SIZE_BYTES];
+
+static O1HeapInstance* heap = NULL;
+
+// Blocks set up by the scenario builders and consumed by the timed operations.
+static void* blk_prev = NULL;
+static void* blk_mid  = NULL;
+static void* blk_next = NULL;
+
+/// A failed state check means the scenario no longer exercises the branch it claims to measure,
+/// rendering the reported numbers meaningless; there is no point in continuing.
+static void check(const bool condition, const char* const what)
+{
+    if (!condition)
+    {
+        printf("FATAL: scenario state check failed: %s\n", what);
+#ifdef PICO_BUILD
+        while (true)
+        {
+            sleep_ms(1000);
+        }
+#else
+        exit(EXIT_FAILURE);
+#endif
+    }
+}
+
+/// Allocates a block whose fragment is exactly the given (power-of-2) fragment size; used by the builders only.
+static void* take(const size_t frag_size)
+{
+    void* const p = o1heapAllocate(heap, AMOUNT(frag_size));
+    check(p != NULL, "state construction allocation");
+    return p;
+}
+
+typedef struct
+{
+    const char* api;
+    const char* branch;
+    void (*build)(void);        ///< Constructs the worst-case state on a freshly initialized heap.
+    uint64_t (*execute)(void);  ///< Runs the timed operation and verifies that the intended branch was taken.
+} Scenario;
+
+// ---------- o1heapAllocate ----------
+
+static void build_nothing(void) {}
+
+/// The deepest split: the smallest possible allocation carved out of the single maximal free fragment,
+/// which also maximizes the bin lookup distance from the optimal bin to the only non-empty one.
+static uint64_t exec_alloc_split(void)
+{
+    const uint64_t a = tic();
+    void* const    p = o1heapAllocate(heap, AMOUNT(U));
+    const uint64_t b = tic();
+    check(p != NULL, "alloc split");
+    return b - a;
+}
+
+static void build_alloc_exact(void)
+{
+    blk_mid = take(U);
+    (void) take(U);  // Barrier: keeps the freed block from merging with the arena remainder.
+    o1heapFree(heap, blk_mid);
+}
+
+/// Exact fit: the requested class is non-empty and the found fragment requires no split.
+static uint64_t exec_alloc_exact(void)
+{
+    const uint64_t a = tic();
+    void* const    p = o1heapAllocate(heap, AMOUNT(U));
+    const uint64_t b = tic();
+    check(p == blk_mid, "alloc exact fit");
+    return b - a;
+}
+
+static void build_alloc_oom(void)
+{
+    while (o1heapAllocate(heap, AMOUNT(32u * U)) != NULL)
+    {
+    }
+}
+
+/// OOM rejection: the bin scan finds nothing and the failure is accounted in the diagnostics.
+static uint64_t exec_alloc_oom(void)
+{
+    const uint64_t a = tic();
+    void* const    p = o1heapAllocate(heap, AMOUNT(32u * U));
+    const uint64_t b = tic();
+    check(p == NULL, "alloc OOM");
+    return b - a;
+}
+
+// ---------- o1heapFree ----------
+
+static void build_free(const bool left_free, const bool right_free)
+{
+    blk_prev = take(32u * U);
+    blk_mid  = take(32u * U);
+    blk_next = take(32u * U);
+    (void) take(U);  // Barrier: isolates the scenario from the arena remainder.
+    if (left_free)
+    {
+        o1heapFree(heap, blk_prev);
+    }
+    if (right_free)
+    {
+        o1heapFree(heap, blk_next);
+    }
+}
+
+static void build_free_merge_both(void)
+{
+    build_free(true, true);
+}
+static void build_free_merge_left(void)
+{
+    build_free(true, false);
+}
+static void build_free_merge_right(void)
+{
+    build_free(false, true);
+}
+static void build_free_merge_none(void)
+{
+    build_free(false, false);
+}
+
+static uint64_t exec_free_mid(void)
+{
+    const uint64_t a = tic();
+    o1heapFree(heap, blk_mid);
+    const uint64_t b = tic();
+    check(o1heapDoInvariantsHold(heap), "free invariants");
+    return b - a;
+}
+
+// ---------- o1heapReallocate ----------
+
+static void build_realloc_plain(void)
+{
+    blk_mid = take(32u * U);
+    (void) take(U);  // Barrier: both neighbors of the block are used.
+}
+
+/// Same size: the request maps onto the current fragment size, so nothing changes.
+static uint64_t exec_realloc_same(void)
+{
+    const uint64_t a = tic();
+    void* const    q = o1heapReallocate(heap, blk_mid, AMOUNT(32u * U));
+    const uint64_t b = tic();
+    check(q == blk_mid, "realloc same size");
+    return b - a;
+}
+
+/// Shrink: the freed tail is split off and rebinned; the next fragment is used, so no merge happens.
+static uint64_t exec_realloc_shrink(void)
+{
+    const uint64_t a = tic();
+    void* const    q = o1heapReallocate(heap, blk_mid, AMOUNT(8u * U));
+    const uint64_t b = tic();
+    check(q == blk_mid, "realloc shrink");
+    return b - a;
+}
+
+static void build_realloc_shrink_merge(void)
+{
+    blk_mid  = take(32u * U);
+    blk_next = take(32u * U);
+    (void) take(U);
+    o1heapFree(heap, blk_next);  // The freed tail of the shrunk block will merge with this fragment.
+}
+
+static void build_realloc_expand_fwd(void)
+{
+    blk_mid  = take(8u * U);
+    blk_next = take(32u * U);
+    (void) take(U);
+    o1heapFree(heap, blk_next);  // The block will grow in place into this fragment.
+}
+
+/// Expand forward: the block grows in place into the free successor; the leftover is split off and rebinned.
+static uint64_t exec_realloc_expand_fwd(void)
+{
+    const uint64_t a = tic();
+    void* const    q = o1heapReallocate(heap, blk_mid, AMOUNT(16u * U));
+    const uint64_t b = tic();
+    check(q == blk_mid, "realloc expand forward");
+    return b - a;
+}
+
+static void build_realloc_expand_bwd(void)
+{
+    blk_prev = take(512u * U);
+    blk_mid  = take(512u * U);
+    (void) take(U);
+    o1heapFree(heap, blk_prev);  // The block will absorb this free predecessor, moving the data backward.
+}
+
+/// Expand backward: the free predecessor is absorbed exactly and the payload is moved with memmove;
+/// the fragment is at the maximum size the arena supports, so this is the worst-case move distance.
+static uint64_t exec_realloc_expand_bwd(void)
+{
+    const uint64_t a = tic();
+    void* const    q = o1heapReallocate(heap, blk_mid, AMOUNT(1024u * U));
+    const uint64_t b = tic();
+    check(q == blk_prev, "realloc expand backward");
+    return b - a;
+}
+
+static void build_realloc_expand_bwd_triple(void)
+{
+    blk_prev = take(512u * U);
+    blk_mid  = take(512u * U);
+    blk_next = take(8u * U);
+    (void) take(U);
+    o1heapFree(heap, blk_prev);
+    o1heapFree(heap, blk_next);  // Too small for a forward expansion, so both neighbors are joined at once.
+}
+
+/// Expand backward joining both neighbors: the worst case of the branch -- two unbins, the memmove,
+/// and the split of the leftover.
+static uint64_t exec_realloc_expand_bwd_triple(void)
+{
+    const uint64_t a = tic();
+    void* const    q = o1heapReallocate(heap, blk_mid, AMOUNT(1024u * U));
+    const uint64_t b = tic();
+    check(q == blk_prev, "realloc expand backward triple");
+    return b - a;
+}
+
+/// Relocation: in-place and near-place expansion are impossible, so a new block is allocated,
+/// the payload is copied, and the old block is freed.
+static uint64_t exec_realloc_move(void)
+{
+    const uint64_t a = tic();
+    void* const    q = o1heapReallocate(heap, blk_mid, AMOUNT(64u * U));
+    const uint64_t b = tic();
+    check((q != NULL) && (q != blk_mid), "realloc move");
+    return b - a;
+}
+
+// ---------- The scenario table ----------
+
+static const Scenario scenarios[] = {
+    {"alloc", "split-deepest", build_nothing, exec_alloc_split},
+    {"alloc", "exact-fit", build_alloc_exact, exec_alloc_exact},
+    {"alloc", "oom", build_alloc_oom, exec_alloc_oom},
+    {"free", "merge-both", build_free_merge_both, exec_free_mid},
+    {"free", "merge-left", build_free_merge_left, exec_free_mid},
+    {"free", "merge-right", build_free_merge_right, exec_free_mid},
+    {"free", "merge-none", build_free_merge_none, exec_free_mid},
+    {"realloc", "same-size", build_realloc_plain, exec_realloc_same},
+    {"realloc", "shrink-split", build_realloc_plain, exec_realloc_shrink},
+    {"realloc", "shrink-merge", build_realloc_shrink_merge, exec_realloc_shrink},
+    {"realloc", "expand-fwd", build_realloc_expand_fwd, exec_realloc_expand_fwd},
+    {"realloc", "expand-bwd-memmove", build_realloc_expand_bwd, exec_realloc_expand_bwd},
+    {"realloc", "expand-bwd-triple", build_realloc_expand_bwd_triple, exec_realloc_expand_bwd_triple},
+    {"realloc", "move-copy-free", build_realloc_plain, exec_realloc_move},
+};
+
+#define SCENARIO_COUNT (sizeof(scenarios) / sizeof(scenarios[0]))
+
+static void run_scenario(const Scenario* const s, const uint64_t overhead)
+{
+    Stats st;
+    stats_init(&st);
+#ifdef PICO_BUILD
+    const uint32_t irq_state = save_and_disable_interrupts();
+#endif
+    for (uint32_t i = 0; i < WCET_ITERATIONS; i++)
+    {
+        heap = o1heapInit(heap_arena, sizeof(heap_arena));
+        check(heap != NULL, "heap initialization");
+        s->build();
+        const uint64_t d = s->execute();
+        stats_add(&st, (d > overhead) ? (d - overhead) : 0u);
+    }
+#ifdef PICO_BUILD
+    restore_interrupts(irq_state);
+#endif
+    printf("%-8s %-20s %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10u\n",
+           s->api,
+           s->branch,
+           st.min,
+           stats_mean(&st, WCET_ITERATIONS),
+           st.max,
+           (unsigned) WCET_ITERATIONS);
+}
+
+static void run_all(void)
+{
+    const uint64_t overhead = measure_overhead();
+    printf("units=%s, heap=%u bytes, iterations=%u, overhead=%" PRIu64 "\n",
+           tic_units(),
+           (unsigned) sizeof(heap_arena),
+           (unsigned) WCET_ITERATIONS,
+           overhead);
+    printf("%-8s %-20s %10s %10s %10s %10s\n", "api", "branch", "min", "mean", "max", "count");
+    for (size_t i = 0; i < SCENARIO_COUNT; i++)
+    {
+        run_scenario(&scenarios[i], overhead);
+    }
+}
+
+int main(void)
+{
+#ifdef PICO_BUILD
+    stdio_uart_init_full(uart0, 115200, 0, 1);
+    sleep_ms(500);
+    cycle_counter_init();
+    printf("\n\n\nO1Heap WCET characterization on RP2350, sysclk=%" PRIu32 " Hz\n", (uint32_t) clock_get_hz(clk_sys));
+    while (true)
+    {
+        printf("\n=== BEGIN ===\n");
+        run_all();
+        printf("===  END  ===\n");
+        sleep_ms(500);
+    }
+#else
+    run_all();
+    return EXIT_SUCCESS;
+#endif
+}
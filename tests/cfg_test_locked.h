@@ -0,0 +1,24 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+#pragma once
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Implemented in the test; backed by a mutex stored in the lock context object.
+void testLockEnter(void* const lock_context);
+void testLockExit(void* const lock_context);
+bool testLockTryEnter(void* const lock_context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define O1HEAP_CRITICAL_SECTION_ENTER(lock_context) testLockEnter(lock_context)
+#define O1HEAP_CRITICAL_SECTION_EXIT(lock_context) testLockExit(lock_context)
+#define O1HEAP_CRITICAL_SECTION_TRY_ENTER(lock_context) testLockTryEnter(lock_context)
@@ -0,0 +1,15 @@
+// This is a config header for O1Heap. It is included from o1heap.c and o1heap_trace.c.
+// It wires the trace hook to the reference ring-buffer recorder so that the recording can be inspected by the test.
+
+#include "o1heap_trace.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+extern O1HeapTraceRecorder g_test_trace_recorder;
+#ifdef __cplusplus
+}
+#endif
+
+#define O1HEAP_TRACE_HOOK(handle, event, pointer, size) \
+    o1heapTraceRecord(&g_test_trace_recorder, (event), (pointer), (size))
@@ -166,6 +166,12 @@ struct O1HeapInstance final
 
     char* arena_end = nullptr;  ///< Points past the last byte of the arena.
 
+    Fragment* uncommitted = nullptr;  ///< Covers the not-yet-committed arena tail; NULL unless lazily initialized.
+
+    Fragment* iterate_cursor = nullptr;  ///< The resumption point of a chunked o1heapIterate() walk.
+
+    Fragment* validate_cursor = nullptr;  ///< The resumption point of a chunked o1heapValidateFull() scan.
+
     /// The same data is available via getDiagnostics(). The duplication is intentional.
     O1HeapDiagnostics diagnostics{};
 
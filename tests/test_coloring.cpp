@@ -0,0 +1,124 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+// This test is built with O1HEAP_COLOR_LOOKAHEAD=4 (with the default cache geometry of 64 sets of 64-byte lines).
+// The instance layout differs from the default one mirrored in internal.hpp, so only the public API is used here.
+
+#include "catch.hpp"
+#include "o1heap.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+constexpr std::size_t ArenaSize = 1024U * 64U;
+
+alignas(O1HEAP_ALIGNMENT) std::array<std::uint8_t, ArenaSize> g_arena{};
+
+/// Mirrors fragColor() with the default geometry: the L1 set index of the first line of the fragment.
+std::size_t colorOf(const void* const pointer)
+{
+    return ((reinterpret_cast<std::size_t>(pointer) - O1HEAP_ALIGNMENT) >> 6U) & 63U;
+}
+
+}  // namespace
+
+TEST_CASE("Coloring: consecutive same-class allocations spread across cache sets")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    // Carve 32 adjacent 1024-byte fragments off the root fragment. Adjacent fragments of this class are 16 sets
+    // apart, so the color pattern repeats with the period of 4 and blocks congruent modulo 4 share a color.
+    constexpr std::size_t Amount = 1000U;  // Rounds up to the 1024-byte fragment (power-of-2 policy).
+    std::array<void*, 32U> blocks{};
+    for (auto& ptr : blocks)
+    {
+        ptr = o1heapAllocate(heap, Amount);
+        REQUIRE(ptr != nullptr);
+    }
+    for (std::size_t i = 1U; i < blocks.size(); i++)
+    {
+        REQUIRE((reinterpret_cast<std::size_t>(blocks.at(i)) - reinterpret_cast<std::size_t>(blocks.at(i - 1U))) ==
+                1024U);
+    }
+
+    // Populate the bin with six fragments of one color followed (at the head, LIFO) by two of another color.
+    // The neighbors of every freed block remain allocated, so no coalescing can disturb the setup.
+    for (const std::size_t i : {0U, 4U, 8U, 12U, 16U, 20U})
+    {
+        o1heapFree(heap, blocks.at(i));
+        blocks.at(i) = nullptr;
+    }
+    for (const std::size_t i : {2U, 6U})
+    {
+        o1heapFree(heap, blocks.at(i));
+        blocks.at(i) = nullptr;
+    }
+    REQUIRE(o1heapDoInvariantsHold(heap));
+
+    // The plain LIFO policy would now serve the two same-colored head entries back-to-back; the colored
+    // selection must alternate between the two available colors instead for as long as both are in reach.
+    std::array<void*, 4U> served{};
+    for (auto& ptr : served)
+    {
+        ptr = o1heapAllocate(heap, Amount);
+        REQUIRE(ptr != nullptr);
+    }
+    REQUIRE(colorOf(served.at(0U)) != colorOf(served.at(1U)));
+    REQUIRE(colorOf(served.at(1U)) != colorOf(served.at(2U)));
+    REQUIRE(colorOf(served.at(2U)) != colorOf(served.at(3U)));
+
+    // The colored selection shall not compromise correctness: the served fragments are usable and distinct.
+    for (std::size_t i = 0U; i < served.size(); i++)
+    {
+        std::memset(served.at(i), static_cast<int>(i), Amount);
+    }
+    for (std::size_t i = 0U; i < served.size(); i++)
+    {
+        REQUIRE(static_cast<const std::uint8_t*>(served.at(i))[Amount - 1U] == i);
+    }
+    REQUIRE(o1heapDoInvariantsHold(heap));
+
+    for (auto* const ptr : served)
+    {
+        o1heapFree(heap, ptr);
+    }
+    for (auto* const ptr : blocks)
+    {
+        o1heapFree(heap, ptr);  // The already-freed entries are NULL, which is a no-op.
+    }
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == 0U);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
+
+TEST_CASE("Coloring: single-candidate bins degrade to the plain policy")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    // With at most one fragment per bin the lookahead finds no alternative and the head is always served,
+    // so the allocator behaves exactly like the uncolored one.
+    void* const a = o1heapAllocate(heap, 100U);
+    REQUIRE(a != nullptr);
+    o1heapFree(heap, a);
+    void* const b = o1heapAllocate(heap, 100U);
+    REQUIRE(b == a);  // The most recently freed fragment is reused.
+    o1heapFree(heap, b);
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == 0U);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
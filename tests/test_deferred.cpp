@@ -0,0 +1,113 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+// This test is built with O1HEAP_ENABLE_DEFERRED_FREE=1; it exercises the deferred free API through the public
+// interface only because the instance layout differs from the default mirrored in internal.hpp.
+
+#include "catch.hpp"
+#include "o1heap.h"
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t ArenaSize = 1024U * 64U;
+
+alignas(O1HEAP_ALIGNMENT) std::array<std::uint8_t, ArenaSize> g_arena{};
+
+}  // namespace
+
+TEST_CASE("Deferred: single-threaded")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    // Draining an empty stack is a no-op.
+    REQUIRE(o1heapDrainDeferred(heap) == 0U);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+
+    // NULL pointers are ignored, like in o1heapFree().
+    o1heapFreeDeferred(heap, nullptr);
+    REQUIRE(o1heapDrainDeferred(heap) == 0U);
+
+    std::array<void*, 32U> pointers{};
+    for (auto& ptr : pointers)
+    {
+        ptr = o1heapAllocate(heap, 123U);
+        REQUIRE(ptr != nullptr);
+    }
+    const std::size_t allocated = o1heapGetDiagnostics(heap).allocated;
+    REQUIRE(allocated > 0U);
+
+    // The memory is not returned to the heap until the drain.
+    for (auto* const ptr : pointers)
+    {
+        o1heapFreeDeferred(heap, ptr);
+    }
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == allocated);
+    REQUIRE(o1heapDrainDeferred(heap) == pointers.size());
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == 0U);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+
+    // After the drain the memory is reusable and adjacent fragments have been merged back.
+    void* const big = o1heapAllocate(heap, 16'000U);
+    REQUIRE(big != nullptr);
+    o1heapFree(heap, big);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
+
+TEST_CASE("Deferred: multi-threaded producers")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    constexpr std::size_t NumThreads       = 4U;
+    constexpr std::size_t BlocksPerThread  = 64U;
+
+    std::array<std::vector<void*>, NumThreads> blocks{};
+    for (auto& vec : blocks)
+    {
+        for (std::size_t i = 0U; i < BlocksPerThread; i++)
+        {
+            void* const ptr = o1heapAllocate(heap, 16U + i);
+            REQUIRE(ptr != nullptr);
+            vec.push_back(ptr);
+        }
+    }
+
+    // Producers push concurrently; the owning thread only drains afterwards.
+    std::vector<std::thread> threads;
+    for (auto& vec : blocks)
+    {
+        threads.emplace_back([heap, &vec]() {
+            for (auto* const ptr : vec)
+            {
+                o1heapFreeDeferred(heap, ptr);
+            }
+        });
+    }
+    for (auto& thr : threads)
+    {
+        thr.join();
+    }
+
+    REQUIRE(o1heapDrainDeferred(heap) == (NumThreads * BlocksPerThread));
+    REQUIRE(o1heapDrainDeferred(heap) == 0U);
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == 0U);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
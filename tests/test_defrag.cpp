@@ -0,0 +1,203 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+// This test is built with O1HEAP_ENABLE_DEFRAG=1 and an enlarged registration table (O1HEAP_DEFRAG_SLOTS=64);
+// it exercises the incremental defragmentation engine through the public interface.
+// The instance layout differs from the default one mirrored in internal.hpp, so only the public API is used here.
+
+#include "catch.hpp"
+#include "o1heap.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t ArenaSize = 1024U * 64U;
+
+alignas(O1HEAP_ALIGNMENT) std::array<std::uint8_t, ArenaSize> g_arena{};
+
+/// The live objects tracked by the test; the relocation callback re-points them as the engine moves them around.
+struct TrackedObject
+{
+    void*        pointer;
+    std::size_t  size;
+    std::uint8_t fill;
+};
+std::vector<TrackedObject> g_objects;   // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+std::size_t                g_moves = 0; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void onMoved(void* const old_pointer, void* const new_pointer)
+{
+    bool found = false;
+    for (auto& obj : g_objects)
+    {
+        if (obj.pointer == old_pointer)
+        {
+            obj.pointer = new_pointer;
+            found       = true;
+        }
+    }
+    REQUIRE(found);
+    REQUIRE(new_pointer < old_pointer);  // Compaction only ever slides objects towards lower addresses.
+    g_moves++;
+}
+
+void verifyContents()
+{
+    for (const auto& obj : g_objects)
+    {
+        const auto* const bytes = static_cast<const std::uint8_t*>(obj.pointer);
+        for (std::size_t i = 0U; i < obj.size; i++)
+        {
+            REQUIRE(bytes[i] == obj.fill);
+        }
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Defrag: incremental compaction heals checkerboard fragmentation")
+{
+    g_objects.clear();
+    g_moves                    = 0U;
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    // Fill the heap with uniform blocks, then free every other one. The resulting free space is large in total
+    // but shredded into gaps no bigger than one block, which the bin policy alone would never heal.
+    constexpr std::size_t BlockAmount = 1000U;  // Rounds up to a 1 KiB fragment.
+    std::vector<void*>    blocks;
+    while (void* const ptr = o1heapAllocate(heap, BlockAmount))
+    {
+        blocks.push_back(ptr);
+    }
+    REQUIRE(blocks.size() > 32U);
+    for (std::size_t i = 0U; i < blocks.size(); i++)
+    {
+        if ((i % 2U) == 0U)
+        {
+            o1heapFree(heap, blocks.at(i));
+        }
+        else
+        {
+            const auto fill = static_cast<std::uint8_t>(i);
+            std::memset(blocks.at(i), fill, BlockAmount);
+            g_objects.push_back({blocks.at(i), BlockAmount, fill});
+            REQUIRE(o1heapMakeRelocatable(heap, blocks.at(i), &onMoved));
+        }
+    }
+    const std::size_t allocated = o1heapGetDiagnostics(heap).allocated;
+
+    // More than 16 KiB is free in total, yet a 10 KiB request cannot be served from the shreds.
+    REQUIRE((o1heapGetDiagnostics(heap).capacity - allocated) > (16U * 1024U));
+    REQUIRE(o1heapAllocate(heap, 10000U) == nullptr);
+
+    // Compact incrementally with a bounded budget per step until no further progress is possible.
+    std::size_t steps = 0U;
+    while (true)
+    {
+        const std::size_t moved = o1heapDefragStep(heap, 4096U);
+        REQUIRE(moved <= 4096U);
+        REQUIRE(o1heapDoInvariantsHold(heap));
+        if (moved == 0U)
+        {
+            break;
+        }
+        steps++;
+        REQUIRE(steps < 1000U);  // Unreachable: compaction must converge.
+    }
+    REQUIRE(g_moves > 0U);
+    verifyContents();
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == allocated);  // Moving does not allocate or free anything.
+
+    // The shreds have coalesced: the request that failed above now succeeds.
+    void* const big = o1heapAllocate(heap, 10000U);
+    REQUIRE(big != nullptr);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
+
+TEST_CASE("Defrag: registration lifecycle and budget")
+{
+    g_objects.clear();
+    g_moves                    = 0U;
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    // [ gap ][ b ]: b can only move if the budget covers its full fragment size.
+    void* const a = o1heapAllocate(heap, 1000U);
+    void* const b = o1heapAllocate(heap, 1000U);
+    REQUIRE(a != nullptr);
+    REQUIRE(b != nullptr);
+    std::memset(b, 0xA5, 1000U);
+    g_objects.push_back({b, 1000U, 0xA5U});
+    REQUIRE(o1heapMakeRelocatable(heap, b, &onMoved));
+    o1heapFree(heap, a);
+    REQUIRE(o1heapDefragStep(heap, 100U) == 0U);  // The budget does not cover the fragment; nothing happens.
+    REQUIRE(g_moves == 0U);
+    const std::size_t moved = o1heapDefragStep(heap, 4096U);
+    REQUIRE(moved >= 1000U);
+    REQUIRE(g_moves == 1U);
+    REQUIRE(g_objects.front().pointer == a);  // Slid into the vacated slot at the lower address.
+    verifyContents();
+    REQUIRE(o1heapDoInvariantsHold(heap));
+
+    // Unregistration stops the engine from touching the object.
+    void* const c = g_objects.front().pointer;
+    REQUIRE(o1heapMakeRelocatable(heap, c, nullptr));
+    REQUIRE(o1heapMakeRelocatable(heap, c, nullptr));  // Removing a missing registration is a benign no-op.
+    o1heapFree(heap, c);
+    g_objects.clear();
+
+    // Freeing a registered object drops its registration, so a later reuse of the same address is not affected.
+    void* const d = o1heapAllocate(heap, 500U);
+    void* const e = o1heapAllocate(heap, 500U);
+    REQUIRE(d != nullptr);
+    REQUIRE(e != nullptr);
+    REQUIRE(o1heapMakeRelocatable(heap, e, &onMoved));
+    o1heapFree(heap, e);
+    void* const f = o1heapAllocate(heap, 500U);  // Likely recycles the same address; it is not registered.
+    REQUIRE(f != nullptr);
+    o1heapFree(heap, d);
+    REQUIRE(o1heapDefragStep(heap, ArenaSize) == 0U);
+    REQUIRE(g_moves == 1U);  // No callback was invoked since the earlier move.
+    REQUIRE(o1heapDoInvariantsHold(heap));
+    o1heapFree(heap, f);
+
+    // A moving reallocation silently re-points the registration: the next defrag step moves the new location
+    // and reports it as the old pointer of the move.
+    void* const g = o1heapAllocate(heap, 1000U);
+    void* const h = o1heapAllocate(heap, 1000U);
+    void* const i = o1heapAllocate(heap, 1000U);
+    REQUIRE(g != nullptr);
+    REQUIRE(h != nullptr);
+    REQUIRE(i != nullptr);
+    REQUIRE(o1heapMakeRelocatable(heap, h, &onMoved));
+    void* const h2 = o1heapReallocate(heap, h, 5000U);  // Cannot grow in place: i blocks the way.
+    REQUIRE(h2 != nullptr);
+    REQUIRE(h2 != h);
+    REQUIRE(g_moves == 1U);  // Reallocation does not invoke the callback; the owner got the pointer directly.
+    std::memset(h2, 0x5AU, 5000U);
+    g_objects.push_back({h2, 5000U, 0x5AU});
+    o1heapFree(heap, g);
+    o1heapFree(heap, i);
+    REQUIRE(o1heapDefragStep(heap, ArenaSize) > 0U);
+    REQUIRE(g_moves == 2U);
+    REQUIRE(g_objects.front().pointer != h2);
+    verifyContents();
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
@@ -0,0 +1,228 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+// This test is built with O1HEAP_ENABLE_DONATE=1; it exercises the cross-instance fragment migration through
+// the public interface only because the instance layout differs from the default mirrored in internal.hpp.
+
+#include "catch.hpp"
+#include "o1heap.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t Granule = O1HEAP_ALIGNMENT * 2U;  ///< The minimum fragment size; anchors cost this much.
+
+alignas(O1HEAP_ALIGNMENT) std::array<std::uint8_t, 256U * 1024U> g_arena_donor{};
+alignas(O1HEAP_ALIGNMENT) std::array<std::uint8_t, 16U * 1024U>  g_arena_recipient{};
+
+}  // namespace
+
+TEST_CASE("Donate: elastic capacity between live heaps")
+{
+    O1HeapInstance* const donor     = o1heapInit(g_arena_donor.data(), g_arena_donor.size());
+    O1HeapInstance* const recipient = o1heapInit(g_arena_recipient.data(), g_arena_recipient.size());
+    REQUIRE(donor != nullptr);
+    REQUIRE(recipient != nullptr);
+
+    // Split the donor's root fragment; the whole free arena cannot be donated because the donor shall remain
+    // a functional heap afterwards.
+    REQUIRE(o1heapDonate(donor, recipient, 1000U) == 0U);
+    void* const pin = o1heapAllocate(donor, 4080U);
+    REQUIRE(pin != nullptr);
+
+    const std::size_t donor_cap_before = o1heapGetDiagnostics(donor).capacity;
+    const std::size_t recip_cap_before = o1heapGetDiagnostics(recipient).capacity;
+
+    // The recipient cannot serve this request from its own small arena.
+    constexpr std::size_t Big = 60'000U;
+    REQUIRE(o1heapAllocate(recipient, Big) == nullptr);
+
+    const std::size_t gain = o1heapDonate(donor, recipient, Big + 1000U);
+    REQUIRE(gain >= (Big + 1000U));
+    REQUIRE(o1heapGetDiagnostics(donor).capacity == (donor_cap_before - gain - Granule));
+    REQUIRE(o1heapGetDiagnostics(recipient).capacity == (recip_cap_before + gain));
+    REQUIRE(o1heapDoInvariantsHold(donor));
+    REQUIRE(o1heapDoInvariantsHold(recipient));
+
+    // The audit walkers continue into the adopted region: the reported fragments account for the entire
+    // capacity, and the deep integrity scan verifies the region chain along with the primary arena.
+    const O1HeapFragmentCallback sum_cb = [](void* const ctx, void* const, const std::size_t cap, const bool) {
+        *static_cast<std::size_t*>(ctx) += cap + O1HEAP_ALIGNMENT;
+        return true;
+    };
+    std::size_t seen = 0U;
+    REQUIRE(o1heapIterate(recipient, sum_cb, &seen, 100'000U) > 1U);
+    REQUIRE(seen == o1heapGetDiagnostics(recipient).capacity);
+    // The donor-side walk skips the allocator-owned anchor of the donated-away region, so the iterated
+    // fragments account exactly for the reduced capacity and no phantom allocation is reported.
+    seen = 0U;
+    REQUIRE(o1heapIterate(donor, sum_cb, &seen, 100'000U) >= 1U);  // Only the pin remains reportable.
+    REQUIRE(seen == o1heapGetDiagnostics(donor).capacity);
+    REQUIRE(o1heapValidateFull(recipient, 100'000U) == O1HeapValidationOK);
+    REQUIRE(o1heapValidateFull(donor, 100'000U) == O1HeapValidationOK);
+
+    // The adopted region serves the request that was previously impossible; the memory is fully usable.
+    void* const big = o1heapAllocate(recipient, Big);
+    REQUIRE(big != nullptr);
+    std::memset(big, 0x7E, Big);
+    o1heapFree(recipient, big);
+    REQUIRE(o1heapGetDiagnostics(recipient).allocated == 0U);
+
+    // Churn across the native arena and the adopted region.
+    std::vector<void*> ptrs;
+    for (void* p = o1heapAllocate(recipient, 1008U); p != nullptr; p = o1heapAllocate(recipient, 1008U))
+    {
+        std::memset(p, 0x11, 1008U);
+        ptrs.push_back(p);
+    }
+    REQUIRE((ptrs.size() * 1024U) > recip_cap_before);  // Proof that the adopted region took part.
+    REQUIRE(o1heapDoInvariantsHold(recipient));
+    for (void* const p : ptrs)
+    {
+        o1heapFree(recipient, p);
+    }
+    REQUIRE(o1heapGetDiagnostics(recipient).allocated == 0U);
+    REQUIRE(o1heapDoInvariantsHold(recipient));
+
+    // The region chain has coalesced back into one fragment, so the large request is servable again.
+    void* const again = o1heapAllocate(recipient, Big);
+    REQUIRE(again != nullptr);
+    o1heapFree(recipient, again);
+
+    // The donor is unaffected by the recipient's traffic.
+    o1heapFree(donor, pin);
+    void* const probe = o1heapAllocate(donor, 1024U);
+    REQUIRE(probe != nullptr);
+    o1heapFree(donor, probe);
+    REQUIRE(o1heapGetDiagnostics(donor).allocated == 0U);
+    REQUIRE(o1heapDoInvariantsHold(donor));
+}
+
+TEST_CASE("Donate: rejection and region table exhaustion")
+{
+    O1HeapInstance* const donor     = o1heapInit(g_arena_donor.data(), g_arena_donor.size());
+    O1HeapInstance* const recipient = o1heapInit(g_arena_recipient.data(), g_arena_recipient.size());
+    REQUIRE(donor != nullptr);
+    REQUIRE(recipient != nullptr);
+
+    // An impossible request is rejected without touching either instance.
+    REQUIRE(o1heapDonate(donor, recipient, g_arena_donor.size()) == 0U);
+
+    // Produce separated free fragments in the donor: allocate a row of blocks and free every other one.
+    std::array<void*, 10U> blocks{};
+    for (auto& b : blocks)
+    {
+        b = o1heapAllocate(donor, 4080U);
+        REQUIRE(b != nullptr);
+    }
+    for (std::size_t i = 1U; i < blocks.size(); i += 2U)
+    {
+        o1heapFree(donor, blocks.at(i));
+        blocks.at(i) = nullptr;
+    }
+
+    // The default region table holds 4 entries; the fifth donation fails even though free fragments remain.
+    for (std::size_t i = 0U; i < 4U; i++)
+    {
+        REQUIRE(o1heapDonate(donor, recipient, 1000U) >= 1000U);
+    }
+    REQUIRE(o1heapDonate(donor, recipient, 1000U) == 0U);
+    REQUIRE(o1heapDoInvariantsHold(donor));
+    REQUIRE(o1heapDoInvariantsHold(recipient));
+
+    // Every adopted region is usable.
+    std::vector<void*> ptrs;
+    for (std::size_t i = 0U; i < 4U; i++)
+    {
+        void* const p = o1heapAllocate(recipient, 2032U);
+        REQUIRE(p != nullptr);
+        std::memset(p, 0x22, 2032U);
+        ptrs.push_back(p);
+    }
+    for (void* const p : ptrs)
+    {
+        o1heapFree(recipient, p);
+    }
+    for (auto& b : blocks)
+    {
+        o1heapFree(donor, b);  // Freeing the remaining blocks; NULL entries are ignored.
+    }
+    REQUIRE(o1heapGetDiagnostics(donor).allocated == 0U);
+    REQUIRE(o1heapGetDiagnostics(recipient).allocated == 0U);
+    REQUIRE(o1heapDoInvariantsHold(donor));
+    REQUIRE(o1heapDoInvariantsHold(recipient));
+}
+
+#ifdef O1HEAP_ENABLE_MARK_RELEASE
+
+TEST_CASE("Donate: rollback spans adopted regions")
+{
+    O1HeapInstance* const donor     = o1heapInit(g_arena_donor.data(), g_arena_donor.size());
+    O1HeapInstance* const recipient = o1heapInit(g_arena_recipient.data(), g_arena_recipient.size());
+    REQUIRE(donor != nullptr);
+    REQUIRE(recipient != nullptr);
+
+    void* const pin = o1heapAllocate(donor, 4080U);  // Split the donor's root fragment to enable donation.
+    REQUIRE(pin != nullptr);
+    const std::size_t gain = o1heapDonate(donor, recipient, 32'000U);
+    REQUIRE(gain >= 32'000U);
+    const std::size_t cap      = o1heapGetDiagnostics(recipient).capacity;
+    const std::size_t base_cap = cap - gain;  // The capacity of the recipient's own arena.
+
+    // An empty episode must be lossless: the adopted region shall survive the bin rebuild intact.
+    REQUIRE(o1heapMark(recipient) == 0U);
+    REQUIRE(o1heapRelease(recipient) == 0U);
+    REQUIRE(o1heapDoInvariantsHold(recipient));
+    void* const probe = o1heapAllocate(recipient, 32'000U);  // Servable only from the adopted region.
+    REQUIRE(probe != nullptr);
+    o1heapFree(recipient, probe);
+
+    // Speculative allocations spilling into the adopted region are rolled back like any other.
+    REQUIRE(o1heapMark(recipient) == 0U);
+    std::size_t count = 0U;
+    for (void* p = o1heapAllocate(recipient, 1008U); p != nullptr; p = o1heapAllocate(recipient, 1008U))
+    {
+        std::memset(p, 0x33, 1008U);
+        count++;
+    }
+    REQUIRE((count * 1024U) > base_cap);  // Proof that the adopted region took part.
+    REQUIRE(o1heapRelease(recipient) == (count * 1024U));
+    REQUIRE(o1heapGetDiagnostics(recipient).allocated == 0U);
+    REQUIRE(o1heapDoInvariantsHold(recipient));
+
+    // The rebuilt bins cover the adopted region, and coalescing frees inside it still work.
+    std::vector<void*> ptrs;
+    for (void* p = o1heapAllocate(recipient, 1008U); p != nullptr; p = o1heapAllocate(recipient, 1008U))
+    {
+        ptrs.push_back(p);
+    }
+    REQUIRE(ptrs.size() == count);  // Nothing was silently lost by the rollback.
+    for (void* const p : ptrs)
+    {
+        o1heapFree(recipient, p);
+    }
+    REQUIRE(o1heapGetDiagnostics(recipient).allocated == 0U);
+    void* const again = o1heapAllocate(recipient, 32'000U);  // The region has coalesced back into one fragment.
+    REQUIRE(again != nullptr);
+    o1heapFree(recipient, again);
+    REQUIRE(o1heapDoInvariantsHold(recipient));
+    REQUIRE(o1heapDoInvariantsHold(donor));
+}
+
+#endif  // O1HEAP_ENABLE_MARK_RELEASE
@@ -1589,3 +1589,491 @@ TEST_CASE("General: invariant checker")
     dg.oom_count++;
     REQUIRE(heap->doInvariantsHold());
 }
+
+TEST_CASE("General: aligned allocation")
+{
+    using internal::Fragment;
+
+    constexpr std::size_t MiB256 = MiB * 256U;
+    const auto            arena  = std::make_unique<std::uint8_t[]>(MiB256);
+    auto                  heap   = init(arena.get(), MiB256);
+    REQUIRE(heap != nullptr);
+    auto* const raw_handle = reinterpret_cast<::O1HeapInstance*>(heap);
+
+    // Invalid alignments are rejected.
+    REQUIRE(o1heapAllocateAligned(raw_handle, 100U, 0U) == nullptr);
+    REQUIRE(o1heapAllocateAligned(raw_handle, 100U, O1HEAP_ALIGNMENT / 2U) == nullptr);
+    REQUIRE(o1heapAllocateAligned(raw_handle, 100U, O1HEAP_ALIGNMENT + 1U) == nullptr);  // Not a power of 2.
+    REQUIRE(o1heapAllocateAligned(raw_handle, 0U, 64U) == nullptr);
+    heap->validate();
+
+    // Every supported alignment yields a correctly aligned, usable payload.
+    for (std::size_t alignment = O1HEAP_ALIGNMENT; alignment <= 4096U; alignment *= 2U)
+    {
+        std::vector<void*> pointers;
+        for (std::size_t amount : {1U, 13U, 64U, 256U, 1000U})
+        {
+            void* const ptr = o1heapAllocateAligned(raw_handle, amount, alignment);
+            REQUIRE(ptr != nullptr);
+            REQUIRE((reinterpret_cast<std::uintptr_t>(ptr) % alignment) == 0U);
+            std::memset(ptr, 0xA5, amount);
+            pointers.push_back(ptr);
+            heap->validate();
+        }
+        for (auto* const ptr : pointers)
+        {
+            o1heapFreeAligned(raw_handle, ptr);
+            heap->validate();
+        }
+    }
+    o1heapFreeAligned(raw_handle, nullptr);  // No-op.
+    REQUIRE(heap->diagnostics.allocated == 0U);
+    REQUIRE(heap->doInvariantsHold());
+}
+
+TEST_CASE("General: batch allocation")
+{
+    using internal::Fragment;
+
+    constexpr std::size_t MiB256 = MiB * 256U;
+    const auto            arena  = std::make_unique<std::uint8_t[]>(MiB256);
+    auto                  heap   = init(arena.get(), MiB256);
+    REQUIRE(heap != nullptr);
+    auto* const raw_handle = reinterpret_cast<::O1HeapInstance*>(heap);
+
+    // Zero-size elements and empty batches are rejected/no-ops.
+    std::array<void*, 64U> pointers{};
+    REQUIRE(o1heapAllocateBatch(raw_handle, 0U, pointers.size(), pointers.data()) == 0U);
+    REQUIRE(o1heapAllocateBatch(raw_handle, 64U, 0U, pointers.data()) == 0U);
+    heap->validate();
+
+    // A full batch is carved off the root fragment in address order.
+    REQUIRE(o1heapAllocateBatch(raw_handle, 64U, pointers.size(), pointers.data()) == pointers.size());
+    const std::size_t frag_size = heap->diagnostics.allocated / pointers.size();  // Rounded-up size class.
+    REQUIRE(frag_size >= (64U + O1HEAP_ALIGNMENT));
+    for (std::size_t i = 0U; i < pointers.size(); i++)
+    {
+        REQUIRE(pointers.at(i) != nullptr);
+        REQUIRE((reinterpret_cast<std::uintptr_t>(pointers.at(i)) % O1HEAP_ALIGNMENT) == 0U);
+        if (i > 0U)
+        {
+            REQUIRE(static_cast<std::uint8_t*>(pointers.at(i)) ==
+                    (static_cast<std::uint8_t*>(pointers.at(i - 1U)) + frag_size));
+        }
+        std::memset(pointers.at(i), 0x5A, 64U);
+    }
+    REQUIRE(heap->diagnostics.allocated == (pointers.size() * frag_size));
+    heap->validate();
+
+    // The batch elements are independent: free some individually, then the rest as a batch.
+    heap->free(pointers.at(0U));
+    pointers.at(0U) = nullptr;
+    o1heapFreeBatch(raw_handle, pointers.data(), pointers.size());  // NULL element is a no-op.
+    REQUIRE(heap->diagnostics.allocated == 0U);
+    heap->validate();
+
+    // A batch that cannot be fully served reports a partial count and bumps oom_count once.
+    const auto        oom_before = heap->diagnostics.oom_count;
+    const std::size_t huge       = heap->getMaxAllocationSize();
+    std::array<void*, 4U> big_pointers{};
+    const std::size_t     served = o1heapAllocateBatch(raw_handle, huge, big_pointers.size(), big_pointers.data());
+    REQUIRE(served < big_pointers.size());
+    REQUIRE(heap->diagnostics.oom_count == (oom_before + 1U));
+    heap->validate();
+    o1heapFreeBatch(raw_handle, big_pointers.data(), served);
+    REQUIRE(heap->diagnostics.allocated == 0U);
+    heap->validate();
+}
+
+TEST_CASE("General: lazy init and extend")
+{
+    constexpr std::size_t ArenaSize = MiB;
+    constexpr std::size_t Committed = 64U * 1024U;
+    constexpr std::size_t FragMin   = O1HEAP_ALIGNMENT * 2U;
+    const auto            arena     = std::make_unique<std::uint8_t[]>(ArenaSize);
+
+    // Only the committed part is usable; the capacity reflects it rather than the whole arena.
+    auto* const heap = o1heapInitLazy(arena.get(), ArenaSize, Committed);
+    REQUIRE(heap != nullptr);
+    REQUIRE(o1heapGetDiagnostics(heap).capacity == Committed);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+    REQUIRE(o1heapAllocate(heap, Committed * 2U) == nullptr);  // Beyond the committed part.
+    REQUIRE(o1heapGetDiagnostics(heap).oom_count == 1U);
+    void* const small = o1heapAllocate(heap, 1024U);
+    REQUIRE(small != nullptr);
+    std::memset(small, 0xA5, 1024U);
+
+    // Extension rounds up to the fragment granularity and grows the capacity accordingly.
+    const std::size_t added = o1heapExtend(heap, 100U);
+    REQUIRE(added >= 100U);
+    REQUIRE((added % FragMin) == 0U);
+    REQUIRE(o1heapGetDiagnostics(heap).capacity == (Committed + added));
+    REQUIRE(o1heapDoInvariantsHold(heap));
+
+    // Committing the rest merges the new space with the free committed tail, enabling large allocations.
+    while (o1heapExtend(heap, ArenaSize) != 0U)
+    {
+    }
+    REQUIRE(o1heapExtend(heap, 1U) == 0U);  // Fully committed; nothing to add.
+    const std::size_t full_capacity = o1heapGetDiagnostics(heap).capacity;
+    REQUIRE(full_capacity > (ArenaSize - ArenaSize / 8U));
+    o1heapFree(heap, small);
+    void* const big = o1heapAllocate(heap, full_capacity / 2U);
+    REQUIRE(big != nullptr);
+    o1heapFree(heap, big);
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == 0U);
+    reinterpret_cast<const internal::O1HeapInstance*>(heap)->validate();  // Fully committed == default layout.
+
+    // Degenerate committed sizes are clamped; SIZE_MAX is equivalent to the eager o1heapInit().
+    auto* const tiny = o1heapInitLazy(arena.get(), ArenaSize, 0U);
+    REQUIRE(tiny != nullptr);
+    REQUIRE(o1heapGetDiagnostics(tiny).capacity == FragMin);
+    auto* const eager = o1heapInitLazy(arena.get(), ArenaSize, SIZE_MAX);
+    REQUIRE(eager != nullptr);
+    REQUIRE(o1heapGetDiagnostics(eager).capacity == full_capacity);
+    REQUIRE(o1heapExtend(eager, 1U) == 0U);
+    reinterpret_cast<const internal::O1HeapInstance*>(eager)->validate();
+}
+
+TEST_CASE("General: try expand and allocated size")
+{
+    using internal::Fragment;
+
+    // Use a 4096-byte heap (after instance overhead) for predictable fragment sizes.
+    alignas(128U) std::array<std::byte, 4096U + sizeof(internal::O1HeapInstance) + O1HEAP_ALIGNMENT - 1U> arena{};
+    auto heap = init(arena.data(), std::size(arena));
+    REQUIRE(heap != nullptr);
+    REQUIRE(heap->diagnostics.capacity == 4096U);
+    auto* const raw_handle = reinterpret_cast<::O1HeapInstance*>(heap);
+
+    // The reported capacity is the rounded-up fragment size minus the header; NULL reports zero.
+    REQUIRE(o1heapGetAllocatedSize(raw_handle, nullptr) == 0U);
+    void* const a = heap->allocate(100U);
+    REQUIRE(a != nullptr);
+    const std::size_t a_capacity = o1heapGetAllocatedSize(raw_handle, a);
+    REQUIRE(a_capacity >= 100U);
+    REQUIRE(a_capacity == (Fragment::constructFromAllocatedMemory(a).header.getSize(heap) - O1HEAP_ALIGNMENT));
+    std::memset(a, 0xA5, a_capacity);  // The entire reported capacity is usable.
+    heap->validate();
+
+    // Growth within the already-owned capacity always succeeds without touching the heap state.
+    const std::size_t allocated_before = heap->diagnostics.allocated;
+    REQUIRE(o1heapTryExpand(raw_handle, a, a_capacity));
+    REQUIRE(heap->diagnostics.allocated == allocated_before);
+    heap->validate();
+
+    // Expansion into the following free fragment succeeds in place and preserves the data.
+    REQUIRE(o1heapTryExpand(raw_handle, a, a_capacity * 4U));
+    REQUIRE(o1heapGetAllocatedSize(raw_handle, a) >= (a_capacity * 4U));
+    REQUIRE(heap->diagnostics.allocated > allocated_before);
+    const auto* const bytes = static_cast<const std::uint8_t*>(a);
+    for (std::size_t i = 0U; i < a_capacity; i++)
+    {
+        REQUIRE(bytes[i] == 0xA5U);
+    }
+    heap->validate();
+
+    // A used neighbor blocks the expansion; the probe fails without moving data or counting an OOM.
+    void* const b = heap->allocate(100U);
+    REQUIRE(b != nullptr);
+    const auto        oom_before  = heap->diagnostics.oom_count;
+    const std::size_t a_cap_now   = o1heapGetAllocatedSize(raw_handle, a);
+    REQUIRE(!o1heapTryExpand(raw_handle, a, a_cap_now + 1U));
+    REQUIRE(o1heapGetAllocatedSize(raw_handle, a) == a_cap_now);
+    REQUIRE(heap->diagnostics.oom_count == oom_before);
+    heap->validate();
+
+    // Degenerate sizes are rejected.
+    REQUIRE(!o1heapTryExpand(raw_handle, b, 0U));
+    REQUIRE(!o1heapTryExpand(raw_handle, b, heap->diagnostics.capacity));
+    REQUIRE(heap->diagnostics.oom_count == oom_before);
+    heap->validate();
+
+    heap->free(a);
+    heap->free(b);
+    REQUIRE(heap->diagnostics.allocated == 0U);
+    REQUIRE(heap->doInvariantsHold());
+}
+
+// The macro is expanded at file scope, the same way an application would use it; the accessor is exercised below.
+O1HEAP_DEFINE_STATIC(staticHeap, 8192U)
+
+TEST_CASE("General: static instance placement")
+{
+    O1HeapInstance* const heap = staticHeap();
+    REQUIRE(heap != nullptr);
+    REQUIRE(staticHeap() == heap);  // Subsequent calls return the same instance without re-initialization.
+    const auto diag = o1heapGetDiagnostics(heap);
+    REQUIRE(diag.capacity > 4096U);
+    REQUIRE(diag.capacity < 8192U);  // The instance itself lives at the beginning of the static arena.
+    void* const a = o1heapAllocate(heap, 123U);
+    REQUIRE(a != nullptr);
+    std::memset(a, 0xA5, 123U);
+    o1heapFree(heap, a);
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == 0U);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+    reinterpret_cast<const internal::O1HeapInstance*>(heap)->validate();
+}
+
+TEST_CASE("General: iterate")
+{
+    using internal::Fragment;
+
+    alignas(O1HEAP_ALIGNMENT) static std::array<std::uint8_t, 64U * KiB> arena{};
+    auto* const heap       = init(arena.data(), arena.size());
+    auto* const raw_handle = reinterpret_cast<O1HeapInstance*>(heap);
+    REQUIRE(heap != nullptr);
+
+    struct Visit
+    {
+        void*       payload  = nullptr;
+        std::size_t capacity = 0U;
+        bool        used     = false;
+    };
+    std::vector<Visit> visits;
+    const auto         visitor = [](void* const context, void* const payload, const std::size_t capacity,
+                            const bool used) -> bool {
+        static_cast<std::vector<Visit>*>(context)->push_back({payload, capacity, used});
+        return true;
+    };
+
+    // A fresh heap is a single free fragment covering the entire capacity.
+    REQUIRE(o1heapIterate(raw_handle, visitor, &visits, 100U) == 1U);
+    REQUIRE(visits.size() == 1U);
+    REQUIRE(!visits.at(0U).used);
+    REQUIRE(visits.at(0U).capacity == (heap->diagnostics.capacity - O1HEAP_ALIGNMENT));
+
+    // Create the pattern [ a ][ free ][ c ][ free tail ] and audit it.
+    void* const a = heap->allocate(1000U);
+    void* const b = heap->allocate(1000U);
+    void* const c = heap->allocate(1000U);
+    REQUIRE(c != nullptr);
+    heap->free(b);
+    visits.clear();
+    REQUIRE(o1heapIterate(raw_handle, visitor, &visits, 100U) == 4U);
+    REQUIRE(visits.size() == 4U);
+    REQUIRE(visits.at(0U).payload == a);
+    REQUIRE(visits.at(0U).used);
+    REQUIRE(visits.at(0U).capacity == o1heapGetAllocatedSize(raw_handle, a));
+    REQUIRE(!visits.at(1U).used);
+    REQUIRE(visits.at(2U).payload == c);
+    REQUIRE(visits.at(2U).used);
+    REQUIRE(!visits.at(3U).used);
+    std::size_t total = 0U;
+    for (const auto& v : visits)
+    {
+        total += v.capacity + O1HEAP_ALIGNMENT;  // The per-fragment overhead is excluded from the capacity.
+    }
+    REQUIRE(total == heap->diagnostics.capacity);
+
+    // A chunked walk yields the same sequence; a return value less than the cap signals completion.
+    std::vector<Visit> chunked;
+    REQUIRE(o1heapIterate(raw_handle, visitor, &chunked, 3U) == 3U);
+    REQUIRE(o1heapIterate(raw_handle, visitor, &chunked, 3U) == 1U);
+    REQUIRE(chunked.size() == 4U);
+    for (std::size_t i = 0U; i < 4U; i++)
+    {
+        REQUIRE(chunked.at(i).payload == visits.at(i).payload);
+        REQUIRE(chunked.at(i).used == visits.at(i).used);
+    }
+
+    // Aborting the walk resets the position: the next walk starts over from the arena base.
+    const auto aborting = [](void* const context, void* const payload, const std::size_t, const bool) -> bool {
+        *static_cast<void**>(context) = payload;
+        return false;
+    };
+    void* first = nullptr;
+    REQUIRE(o1heapIterate(raw_handle, aborting, &first, 100U) == 1U);
+    REQUIRE(first == a);
+    first = nullptr;
+    REQUIRE(o1heapIterate(raw_handle, aborting, &first, 100U) == 1U);
+    REQUIRE(first == a);
+
+    // A zero cap only resets the position.
+    REQUIRE(o1heapIterate(raw_handle, visitor, &visits, 0U) == 0U);
+
+    heap->free(a);
+    heap->free(c);
+    visits.clear();
+    REQUIRE(o1heapIterate(raw_handle, visitor, &visits, 100U) == 1U);  // Everything has coalesced back.
+    REQUIRE(!visits.at(0U).used);
+    REQUIRE(heap->diagnostics.allocated == 0U);
+    heap->validate();
+}
+
+TEST_CASE("General: full validation")
+{
+    using internal::Fragment;
+
+    alignas(O1HEAP_ALIGNMENT) static std::array<std::uint8_t, 64U * KiB> arena{};
+    auto* const heap       = init(arena.data(), arena.size());
+    auto* const raw_handle = reinterpret_cast<O1HeapInstance*>(heap);
+    REQUIRE(heap != nullptr);
+
+    // A fresh heap is a single fragment; one increment completes the scan.
+    REQUIRE(o1heapValidateFull(raw_handle, 10U) == O1HeapValidationOK);
+
+    // Create the pattern [ a ][ free ][ c ][ free tail ] and scan it in chunks.
+    void* const a = heap->allocate(1000U);
+    void* const b = heap->allocate(1000U);
+    void* const c = heap->allocate(1000U);
+    REQUIRE(c != nullptr);
+    heap->free(b);
+    REQUIRE(o1heapValidateFull(raw_handle, 3U) == O1HeapValidationPending);
+    REQUIRE(o1heapValidateFull(raw_handle, 3U) == O1HeapValidationOK);
+    REQUIRE(o1heapValidateFull(raw_handle, 100U) == O1HeapValidationOK);  // Completion resets; starts over.
+
+    // A corrupted prev pointer is caught gracefully, without assertion failures even in debug builds.
+    // The first fragment has no predecessor, so any non-NULL prev is out of the arena bounds.
+    auto* const a_prev_used = reinterpret_cast<std::uintptr_t*>(static_cast<char*>(a) - O1HEAP_ALIGNMENT) + 1U;
+    const auto  a_saved     = *a_prev_used;
+    *a_prev_used            = a_saved | static_cast<std::uintptr_t>(0x40U);
+    REQUIRE(o1heapValidateFull(raw_handle, 100U) == O1HeapValidationFailed);
+    *a_prev_used = a_saved;
+    REQUIRE(o1heapValidateFull(raw_handle, 100U) == O1HeapValidationOK);
+
+    // A broken segregated-list link of a free fragment is caught as well. The next_free pointer of the freed
+    // middle fragment lives in the first payload word; aiming it at the used fragment of a, whose payload is
+    // zeroed below, breaks the back-link requirement deterministically.
+    std::memset(a, 0, o1heapGetAllocatedSize(raw_handle, a));
+    auto** const b_next_free = reinterpret_cast<void**>(b);
+    auto* const  b_saved     = *b_next_free;
+    *b_next_free             = static_cast<char*>(a) - O1HEAP_ALIGNMENT;
+    REQUIRE(o1heapValidateFull(raw_handle, 100U) == O1HeapValidationFailed);
+    *b_next_free = b_saved;
+    REQUIRE(o1heapValidateFull(raw_handle, 100U) == O1HeapValidationOK);
+
+    // A zero cap only resets the scan position.
+    REQUIRE(o1heapValidateFull(raw_handle, 2U) == O1HeapValidationPending);
+    REQUIRE(o1heapValidateFull(raw_handle, 0U) == O1HeapValidationOK);
+    REQUIRE(o1heapValidateFull(raw_handle, 100U) == O1HeapValidationOK);
+
+    heap->free(a);
+    heap->free(c);
+    REQUIRE(o1heapValidateFull(raw_handle, 100U) == O1HeapValidationOK);
+    REQUIRE(heap->diagnostics.allocated == 0U);
+    heap->validate();
+}
+
+TEST_CASE("General: largest available")
+{
+    using internal::Fragment;
+
+    alignas(O1HEAP_ALIGNMENT) static std::array<std::uint8_t, 64U * KiB> arena{};
+    auto* const heap       = init(arena.data(), arena.size());
+    auto* const raw_handle = reinterpret_cast<O1HeapInstance*>(heap);
+    REQUIRE(heap != nullptr);
+
+    // On a fresh heap the value coincides with the static theoretical bound.
+    REQUIRE(o1heapGetLargestAvailable(raw_handle) == heap->getMaxAllocationSize());
+
+    // The returned amount is always allocatable, and the query burns no oom_count even near exhaustion.
+    std::vector<void*> held;
+    for (;;)
+    {
+        const std::size_t avail = o1heapGetLargestAvailable(raw_handle);
+        if (avail == 0U)
+        {
+            break;
+        }
+        const auto oom_before = heap->diagnostics.oom_count;
+        void* const ptr       = heap->allocate(avail);
+        REQUIRE(ptr != nullptr);  // The guarantee: the reported amount shall be served.
+        REQUIRE(heap->diagnostics.oom_count == oom_before);
+        held.push_back(ptr);
+    }
+    REQUIRE(heap->diagnostics.oom_count == 0U);
+    REQUIRE(o1heapGetLargestAvailable(raw_handle) == 0U);  // No free fragment remains at all.
+
+    // Freeing restores the availability; coalescing is reflected immediately.
+    for (auto* const ptr : held)
+    {
+        heap->free(ptr);
+    }
+    REQUIRE(o1heapGetLargestAvailable(raw_handle) == heap->getMaxAllocationSize());
+    REQUIRE(heap->diagnostics.allocated == 0U);
+    heap->validate();
+}
+
+TEST_CASE("General: hinted reallocation")
+{
+    alignas(128U) std::array<std::byte, 16384U + sizeof(internal::O1HeapInstance) + O1HEAP_ALIGNMENT - 1U> arena{};
+    auto heap = init(arena.data(), std::size(arena));
+    REQUIRE(heap != nullptr);
+    REQUIRE(heap->diagnostics.capacity == 16384U);
+    auto* const raw_handle = reinterpret_cast<::O1HeapInstance*>(heap);
+
+    // The delegation cases mirror o1heapReallocate(), except that NULL allocates for the expected final amount.
+    void* const early = o1heapReallocateHinted(raw_handle, nullptr, 300U, 4000U);
+    REQUIRE(early != nullptr);
+    REQUIRE(o1heapGetAllocatedSize(raw_handle, early) >= 4000U);
+    heap->validate();
+    REQUIRE(o1heapReallocateHinted(raw_handle, early, 0U, 4000U) == nullptr);
+    REQUIRE(heap->diagnostics.allocated == 0U);
+    heap->validate();
+
+    // The reassembly pattern: a buffer grows in small steps behind a blocker, with the final size known upfront.
+    // The hinted growth moves the payload exactly once; every subsequent step stays in place.
+    void* const a = heap->allocate(496U);
+    void* const blocker = heap->allocate(496U);
+    REQUIRE(((a != nullptr) && (blocker != nullptr)));
+    std::memset(a, 0x5A, 496U);
+    void* const moved = o1heapReallocateHinted(raw_handle, a, 700U, 3000U);
+    REQUIRE(moved != nullptr);
+    REQUIRE(moved != a);  // The blocker forced one move...
+    REQUIRE(o1heapGetAllocatedSize(raw_handle, moved) >= 3000U);  // ...sized for the final amount.
+    heap->validate();
+    const std::size_t settled = heap->diagnostics.allocated;
+    void* grown = moved;
+    for (std::size_t amount = 1000U; amount <= 3000U; amount += 500U)
+    {
+        grown = o1heapReallocateHinted(raw_handle, grown, amount, 3000U);
+        REQUIRE(grown == moved);  // In place, nothing reallocated.
+        REQUIRE(heap->diagnostics.allocated == settled);
+        heap->validate();
+    }
+    for (std::size_t i = 0U; i < 496U; i++)
+    {
+        REQUIRE(static_cast<const std::uint8_t*>(grown)[i] == 0x5AU);
+    }
+
+    // The fragment is never shrunk; the slack is the headroom that avoids the next move.
+    REQUIRE(o1heapReallocateHinted(raw_handle, grown, 100U, 0U) == grown);
+    REQUIRE(heap->diagnostics.allocated == settled);
+    heap->free(grown);
+    heap->free(blocker);
+    REQUIRE(heap->diagnostics.allocated == 0U);
+    heap->validate();
+
+    // When a fragment sized for the hint cannot be allocated, the call degrades to a plain reallocation,
+    // which may still succeed via the expand-backward merge instead of failing the request.
+    void* const x = heap->allocate(1008U);
+    void* const y = heap->allocate(1008U);
+    REQUIRE(((x != nullptr) && (y != nullptr)));
+    std::vector<void*> hog;  // Consume the rest of the arena.
+    for (std::size_t avail = o1heapGetLargestAvailable(raw_handle); avail > 0U;
+         avail             = o1heapGetLargestAvailable(raw_handle))
+    {
+        hog.push_back(heap->allocate(avail));
+        REQUIRE(hog.back() != nullptr);
+    }
+    REQUIRE(o1heapGetLargestAvailable(raw_handle) == 0U);
+    std::memset(y, 0xC3, 1008U);
+    heap->free(x);  // Only the hole preceding y remains free; a fresh hinted fragment cannot fit anywhere.
+    void* const backed = o1heapReallocateHinted(raw_handle, y, 1900U, 60000U);
+    REQUIRE(backed != nullptr);
+    REQUIRE(backed != y);  // Expanded backward into the freed predecessor, moving the data within the merge.
+    REQUIRE(o1heapGetAllocatedSize(raw_handle, backed) >= 1900U);
+    for (std::size_t i = 0U; i < 1008U; i++)
+    {
+        REQUIRE(static_cast<const std::uint8_t*>(backed)[i] == 0xC3U);
+    }
+    heap->validate();
+    heap->free(backed);
+    for (auto* const p : hog)
+    {
+        heap->free(p);
+    }
+    REQUIRE(heap->diagnostics.allocated == 0U);
+    REQUIRE(heap->doInvariantsHold());
+}
@@ -0,0 +1,136 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+// This test builds the locking layer with the critical-section macros mapped to a std::mutex via cfg_test_locked.h.
+// The wrapped instance is accessed through the public API only.
+
+#include "catch.hpp"
+#include "cfg_test_locked.h"  // For the declarations of the lock functions defined below.
+#include "o1heap_locked.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+extern "C" {
+void testLockEnter(void* const lock_context)
+{
+    static_cast<std::mutex*>(lock_context)->lock();
+}
+void testLockExit(void* const lock_context)
+{
+    static_cast<std::mutex*>(lock_context)->unlock();
+}
+bool testLockTryEnter(void* const lock_context)
+{
+    return static_cast<std::mutex*>(lock_context)->try_lock();
+}
+}
+
+namespace
+{
+constexpr std::size_t ArenaSize = 1024U * 256U;
+
+alignas(O1HEAP_ALIGNMENT) std::array<std::uint8_t, ArenaSize> g_arena{};
+
+std::mutex g_mutex;
+
+}  // namespace
+
+TEST_CASE("Locked: basic semantics")
+{
+    REQUIRE(o1heapLockedMinArenaSize() > o1heapMinArenaSize);
+    REQUIRE(nullptr == o1heapInitLocked(nullptr, ArenaSize, &g_mutex));
+    REQUIRE(nullptr == o1heapInitLocked(g_arena.data(), o1heapLockedMinArenaSize() - 1U, &g_mutex));
+
+    O1HeapLockedInstance* const heap = o1heapInitLocked(g_arena.data(), g_arena.size(), &g_mutex);
+    REQUIRE(heap != nullptr);
+    REQUIRE(o1heapLockedGetHeap(heap) != nullptr);
+    REQUIRE(o1heapLockedGetContentionCount(heap) == 0U);
+
+    void* const a = o1heapLockedAllocate(heap, 1000U);
+    REQUIRE(a != nullptr);
+    void* const b = o1heapLockedReallocate(heap, a, 2000U);
+    REQUIRE(b != nullptr);
+    REQUIRE(o1heapLockedGetDiagnostics(heap).allocated > 0U);
+    o1heapLockedFree(heap, b);
+    o1heapLockedFree(heap, nullptr);  // NULL is ignored, like in o1heapFree().
+    REQUIRE(o1heapLockedGetDiagnostics(heap).allocated == 0U);
+    REQUIRE(o1heapLockedDoInvariantsHold(heap));
+    // No other thread touched the heap, so no contention could have been observed.
+    REQUIRE(o1heapLockedGetContentionCount(heap) == 0U);
+}
+
+TEST_CASE("Locked: concurrent hammering")
+{
+    O1HeapLockedInstance* const heap = o1heapInitLocked(g_arena.data(), g_arena.size(), &g_mutex);
+    REQUIRE(heap != nullptr);
+
+    constexpr std::size_t NumThreads = 4U;
+    constexpr std::size_t NumRounds  = 2000U;
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0U; t < NumThreads; t++)
+    {
+        threads.emplace_back([heap, t]() {
+            std::vector<void*> held;
+            for (std::size_t i = 0U; i < NumRounds; i++)
+            {
+                void* const ptr = o1heapLockedAllocate(heap, 16U + ((t * 97U + i * 13U) % 500U));
+                if (ptr != nullptr)
+                {
+                    held.push_back(ptr);
+                }
+                if ((held.size() > 8U) || ((ptr == nullptr) && !held.empty()))
+                {
+                    o1heapLockedFree(heap, held.back());
+                    held.pop_back();
+                }
+            }
+            for (auto* const ptr : held)
+            {
+                o1heapLockedFree(heap, ptr);
+            }
+        });
+    }
+    for (auto& thr : threads)
+    {
+        thr.join();
+    }
+
+    REQUIRE(o1heapLockedGetDiagnostics(heap).allocated == 0U);
+    REQUIRE(o1heapLockedDoInvariantsHold(heap));
+}
+
+TEST_CASE("Locked: contention counter")
+{
+    O1HeapLockedInstance* const heap = o1heapInitLocked(g_arena.data(), g_arena.size(), &g_mutex);
+    REQUIRE(heap != nullptr);
+    REQUIRE(o1heapLockedGetContentionCount(heap) == 0U);
+
+    // Hold the lock directly while another thread attempts an allocation; the entry is guaranteed contended.
+    g_mutex.lock();
+    std::thread blocked([heap]() { o1heapLockedFree(heap, o1heapLockedAllocate(heap, 64U)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    g_mutex.unlock();
+    blocked.join();
+
+    REQUIRE(o1heapLockedGetContentionCount(heap) >= 1U);
+    REQUIRE(o1heapLockedGetDiagnostics(heap).allocated == 0U);
+    REQUIRE(o1heapLockedDoInvariantsHold(heap));
+}
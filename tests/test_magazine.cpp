@@ -0,0 +1,127 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+// This test is built with O1HEAP_MAGAZINE_BINS=4 and O1HEAP_MAGAZINE_DEPTH=8; it exercises the magazine cache
+// through the public interface only because the instance layout differs from the default mirrored in internal.hpp.
+
+#include "catch.hpp"
+#include "o1heap.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t ArenaSize     = 1024U * 64U;
+constexpr std::size_t MagazineDepth = 8U;
+
+alignas(O1HEAP_ALIGNMENT) std::array<std::uint8_t, ArenaSize> g_arena{};
+
+}  // namespace
+
+TEST_CASE("Magazine: LIFO reuse")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    // A freed small fragment is parked in its magazine: it stays accounted as allocated,
+    // and the next allocation of the same class pops it straight back.
+    void* const ptr = o1heapAllocate(heap, 64U);
+    REQUIRE(ptr != nullptr);
+    const std::size_t allocated = o1heapGetDiagnostics(heap).allocated;
+    o1heapFree(heap, ptr);
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == allocated);
+    REQUIRE(o1heapAllocate(heap, 64U) == ptr);
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == allocated);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+    o1heapFree(heap, ptr);
+}
+
+TEST_CASE("Magazine: overflow flush")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    std::array<void*, MagazineDepth + 1U> pointers{};
+    for (auto& p : pointers)
+    {
+        p = o1heapAllocate(heap, 64U);
+        REQUIRE(p != nullptr);
+    }
+    const std::size_t frag_size = o1heapGetDiagnostics(heap).allocated / pointers.size();
+
+    // The first MagazineDepth frees fill the magazine; the last one triggers a flush of the full magazine
+    // back into the bins before being parked itself.
+    for (auto* const p : pointers)
+    {
+        o1heapFree(heap, p);
+    }
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == frag_size);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
+
+TEST_CASE("Magazine: large allocations bypass the cache")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    void* const big = o1heapAllocate(heap, 4096U);
+    REQUIRE(big != nullptr);
+    REQUIRE(o1heapGetDiagnostics(heap).allocated > 0U);
+    o1heapFree(heap, big);
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == 0U);  // Went straight back into the bins.
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
+
+TEST_CASE("Magazine: mixed stress")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    std::uint32_t                    rng = 0x9E3779B9U;
+    const auto                       rand_u32 = [&rng]() {
+        rng = (rng * 1664525U) + 1013904223U;
+        return rng;
+    };
+    std::vector<std::pair<void*, std::size_t>> live;
+    for (std::size_t iteration = 0U; iteration < 10'000U; iteration++)
+    {
+        if (((rand_u32() % 2U) == 0U) || live.empty())
+        {
+            const std::size_t amount = 1U + (rand_u32() % 600U);  // Mix of cached and uncached classes.
+            void* const       ptr    = o1heapAllocate(heap, amount);
+            if (ptr != nullptr)
+            {
+                std::memset(ptr, static_cast<int>(iteration & 0xFFU), amount);
+                live.emplace_back(ptr, amount);
+            }
+        }
+        else
+        {
+            const std::size_t idx = rand_u32() % live.size();
+            o1heapFree(heap, live.at(idx).first);
+            live.at(idx) = live.back();
+            live.pop_back();
+        }
+    }
+    REQUIRE(o1heapDoInvariantsHold(heap));
+    for (const auto& [ptr, amount] : live)
+    {
+        o1heapFree(heap, ptr);
+    }
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
@@ -0,0 +1,141 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+// This test is built with O1HEAP_ENABLE_MARK_RELEASE=1; it exercises the checkpoint/rollback API through the
+// public interface only because the instance layout differs from the default mirrored in internal.hpp.
+
+#include "catch.hpp"
+#include "o1heap.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t ArenaSize = 1024U * 64U;
+
+alignas(O1HEAP_ALIGNMENT) std::array<std::uint8_t, ArenaSize> g_arena{};
+
+}  // namespace
+
+TEST_CASE("MarkRelease: basic rollback")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    // Pre-mark objects survive the rollback intact.
+    void* const durable = o1heapAllocate(heap, 256U);
+    REQUIRE(durable != nullptr);
+    std::memset(durable, 0x5A, 256U);
+
+    const std::size_t watermark = o1heapMark(heap);
+    REQUIRE(watermark == o1heapGetDiagnostics(heap).allocated);
+
+    std::array<void*, 24U> speculative{};
+    for (auto& p : speculative)
+    {
+        p = o1heapAllocate(heap, 100U);
+        REQUIRE(p != nullptr);
+    }
+    REQUIRE(o1heapGetDiagnostics(heap).allocated > watermark);
+
+    const std::size_t speculative_total = o1heapGetDiagnostics(heap).allocated - watermark;
+    REQUIRE(o1heapRelease(heap) == speculative_total);
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == watermark);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+
+    // The durable object is untouched and the reclaimed space is allocatable again.
+    for (std::size_t i = 0U; i < 256U; i++)
+    {
+        REQUIRE(static_cast<const std::uint8_t*>(durable)[i] == 0x5AU);
+    }
+    void* const again = o1heapAllocate(heap, 100U);
+    REQUIRE(again != nullptr);
+    o1heapFree(heap, again);
+    o1heapFree(heap, durable);
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == 0U);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
+
+TEST_CASE("MarkRelease: frees during the episode")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    void* const a = o1heapAllocate(heap, 128U);
+    void* const b = o1heapAllocate(heap, 128U);
+    REQUIRE(a != nullptr);
+    REQUIRE(b != nullptr);
+    const std::size_t fragment_size = o1heapGetDiagnostics(heap).allocated / 2U;
+
+    const std::size_t watermark = o1heapMark(heap);
+
+    // Speculative allocations may be freed individually before the release; pre-mark objects may be freed too.
+    void* const x = o1heapAllocate(heap, 300U);
+    void* const y = o1heapAllocate(heap, 300U);
+    REQUIRE(x != nullptr);
+    REQUIRE(y != nullptr);
+    o1heapFree(heap, y);
+    o1heapFree(heap, a);
+
+    (void) o1heapRelease(heap);
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == (watermark - fragment_size));  // Only b remains.
+    REQUIRE(o1heapDoInvariantsHold(heap));
+    o1heapFree(heap, b);
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == 0U);
+}
+
+TEST_CASE("MarkRelease: empty episode and reuse")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    (void) o1heapMark(heap);
+    REQUIRE(o1heapRelease(heap) == 0U);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+
+    // Repeated abort cycles shall not leak or corrupt anything.
+    std::uint32_t rng      = 0xDEADBEEFU;
+    const auto    rand_u32 = [&rng]() {
+        rng = (rng * 1664525U) + 1013904223U;
+        return rng;
+    };
+    for (std::size_t cycle = 0U; cycle < 100U; cycle++)
+    {
+        const std::size_t watermark = o1heapMark(heap);
+        std::vector<void*> pointers;
+        for (std::size_t i = 0U; i < 50U; i++)
+        {
+            void* const ptr = o1heapAllocate(heap, 1U + (rand_u32() % 500U));
+            if (ptr != nullptr)
+            {
+                pointers.push_back(ptr);
+            }
+        }
+        if ((cycle % 3U) == 0U)  // Some episodes free a part of their own allocations first.
+        {
+            for (std::size_t i = 0U; i < (pointers.size() / 2U); i++)
+            {
+                o1heapFree(heap, pointers.at(i));
+            }
+        }
+        (void) o1heapRelease(heap);
+        REQUIRE(o1heapGetDiagnostics(heap).allocated == watermark);
+        REQUIRE(o1heapDoInvariantsHold(heap));
+    }
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == 0U);
+}
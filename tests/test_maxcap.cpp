@@ -0,0 +1,102 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+// This test is built with O1HEAP_MAX_CAPACITY_LOG2=17 (128 KiB cap); it exercises the compact-instance
+// configuration through the public interface only because the instance layout differs from the default
+// mirrored in internal.hpp.
+
+#include "catch.hpp"
+#include "o1heap.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t CapacityCap = std::size_t{1U} << 17U;
+
+alignas(O1HEAP_ALIGNMENT) std::array<std::uint8_t, CapacityCap * 2U> g_arena{};
+
+}  // namespace
+
+TEST_CASE("Maxcap: compact instance footprint")
+{
+    // Only the reachable size classes are provisioned, so the instance overhead shrinks from one bin pointer
+    // per size_t bit to a couple of cache lines; the minimum arena reflects that.
+    REQUIRE(O1HEAP_BIN_COUNT < (sizeof(std::size_t) * 8U));
+    REQUIRE(o1heapMinArenaSize <= 512U);
+}
+
+TEST_CASE("Maxcap: arenas are clipped to the cap")
+{
+    // An arena larger than the cap is usable; the excess is simply not part of the heap.
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+    const auto diag = o1heapGetDiagnostics(heap);
+    REQUIRE(diag.capacity == CapacityCap);
+    REQUIRE(o1heapGetMaxAllocationSize(heap) == (CapacityCap - O1HEAP_ALIGNMENT));
+
+    // The largest representable allocation is served; anything bigger is rejected as OOM.
+    void* const big = o1heapAllocate(heap, o1heapGetMaxAllocationSize(heap));
+    REQUIRE(big != nullptr);
+    std::memset(big, 0xA5, o1heapGetMaxAllocationSize(heap));
+    REQUIRE(o1heapAllocate(heap, 1U) == nullptr);
+    o1heapFree(heap, big);
+    REQUIRE(o1heapAllocate(heap, CapacityCap) == nullptr);
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == 0U);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
+
+TEST_CASE("Maxcap: mixed stress")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    std::uint32_t  rng      = 0x2545F491U;
+    const auto     rand_u32 = [&rng]() {
+        rng = (rng * 1664525U) + 1013904223U;
+        return rng >> 8U;
+    };
+    std::vector<std::pair<void*, std::size_t>> live;
+    for (std::size_t iteration = 0U; iteration < 20'000U; iteration++)
+    {
+        if (((rand_u32() % 2U) == 0U) || live.empty())
+        {
+            const std::size_t amount = 1U + (rand_u32() % 2000U);
+            void* const       ptr    = o1heapAllocate(heap, amount);
+            if (ptr != nullptr)
+            {
+                std::memset(ptr, static_cast<int>(iteration & 0xFFU), amount);
+                live.emplace_back(ptr, amount);
+            }
+        }
+        else
+        {
+            const std::size_t idx = rand_u32() % live.size();
+            o1heapFree(heap, live.at(idx).first);
+            live.at(idx) = live.back();
+            live.pop_back();
+        }
+    }
+    REQUIRE(o1heapDoInvariantsHold(heap));
+    for (const auto& rec : live)
+    {
+        o1heapFree(heap, rec.first);
+    }
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == 0U);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
@@ -0,0 +1,126 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+#include "catch.hpp"
+#include "o1heap_multi.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+// The regions model a typical MCU memory map: a small fast TCM-like region and a larger slow one.
+// They are deliberately separate objects so that their addresses are discontiguous.
+constexpr std::size_t FastSize = 1024U * 32U;
+constexpr std::size_t SlowSize = 1024U * 128U;
+
+alignas(O1HEAP_ALIGNMENT) std::array<std::uint8_t, FastSize> g_fast{};
+alignas(O1HEAP_ALIGNMENT) std::array<std::uint8_t, SlowSize> g_slow{};
+
+bool within(const void* const ptr, const void* const base, const std::size_t size)
+{
+    const auto* const p = static_cast<const std::uint8_t*>(ptr);
+    const auto* const b = static_cast<const std::uint8_t*>(base);
+    return (p >= b) && (p < (b + size));
+}
+
+}  // namespace
+
+TEST_CASE("Multi: init and arena registration")
+{
+    REQUIRE(o1heapMultiMinArenaSize() > o1heapMinArenaSize);
+
+    REQUIRE(o1heapInitMulti(nullptr, FastSize) == nullptr);
+    REQUIRE(o1heapInitMulti(g_fast.data() + 1U, FastSize - 1U) == nullptr);  // Misaligned.
+    REQUIRE(o1heapInitMulti(g_fast.data(), o1heapMultiMinArenaSize() - 1U) == nullptr);
+
+    O1HeapMultiInstance* const heap = o1heapInitMulti(g_fast.data(), FastSize);
+    REQUIRE(heap != nullptr);
+    REQUIRE(o1heapMultiGetArenaCount(heap) == 1U);
+    REQUIRE(o1heapMultiGetArena(heap, 0U) != nullptr);
+    REQUIRE(o1heapMultiGetArena(heap, 1U) == nullptr);
+
+    REQUIRE(!o1heapMultiAddArena(heap, nullptr, SlowSize));
+    REQUIRE(!o1heapMultiAddArena(heap, g_slow.data() + 1U, SlowSize - 1U));  // Misaligned.
+    REQUIRE(!o1heapMultiAddArena(heap, g_slow.data(), o1heapMinArenaSize - 1U));
+
+    REQUIRE(o1heapMultiAddArena(heap, g_slow.data(), SlowSize));
+    REQUIRE(o1heapMultiGetArenaCount(heap) == 2U);
+    for (std::size_t i = 0U; i < 2U; i++)
+    {
+        O1HeapInstance* const arena = o1heapMultiGetArena(heap, i);
+        REQUIRE(arena != nullptr);
+        REQUIRE(o1heapDoInvariantsHold(arena));
+        REQUIRE(o1heapGetDiagnostics(arena).allocated == 0U);
+    }
+    // The slow region is larger, so its capacity shall exceed that of the fast one.
+    REQUIRE(o1heapGetDiagnostics(o1heapMultiGetArena(heap, 1U)).capacity >
+            o1heapGetDiagnostics(o1heapMultiGetArena(heap, 0U)).capacity);
+}
+
+TEST_CASE("Multi: affinity and overflow")
+{
+    O1HeapMultiInstance* const heap = o1heapInitMulti(g_fast.data(), FastSize);
+    REQUIRE(heap != nullptr);
+    REQUIRE(o1heapMultiAddArena(heap, g_slow.data(), SlowSize));
+
+    // The default hint lands allocations in the fast region while it has space.
+    void* const fast_block = o1heapMultiAllocate(heap, 256U);
+    REQUIRE(fast_block != nullptr);
+    REQUIRE(within(fast_block, g_fast.data(), FastSize));
+
+    // The slow hint routes bulk buffers away from the fast region even though it has space.
+    void* const slow_block = o1heapMultiAllocateHinted(heap, 256U, O1HeapMultiHintSlow);
+    REQUIRE(slow_block != nullptr);
+    REQUIRE(within(slow_block, g_slow.data(), SlowSize));
+
+    // Exhaust the fast region until it cannot serve 1 KiB requests anymore.
+    std::vector<void*> blocks;
+    while (void* const ptr = o1heapAllocate(o1heapMultiGetArena(heap, 0U), 1024U))
+    {
+        std::memset(ptr, 0x5A, 1024U);
+        blocks.push_back(ptr);
+        if (blocks.size() > (FastSize / 1024U))
+        {
+            FAIL("Unreachable: the fast region should have been exhausted by now");
+        }
+    }
+
+    // The fast region is full, so the next allocation shall overflow into the slow one instead of failing.
+    void* const overflow = o1heapMultiAllocate(heap, 1024U);
+    REQUIRE(overflow != nullptr);
+    REQUIRE(within(overflow, g_slow.data(), SlowSize));
+
+    // Frees are routed back to the owning regions purely by address.
+    o1heapMultiFree(heap, overflow);
+    o1heapMultiFree(heap, fast_block);
+    o1heapMultiFree(heap, slow_block);
+    for (auto* const ptr : blocks)
+    {
+        o1heapMultiFree(heap, ptr);
+    }
+    o1heapMultiFree(heap, nullptr);  // No-op.
+    for (std::size_t i = 0U; i < 2U; i++)
+    {
+        REQUIRE(o1heapDoInvariantsHold(o1heapMultiGetArena(heap, i)));
+        REQUIRE(o1heapGetDiagnostics(o1heapMultiGetArena(heap, i)).allocated == 0U);
+    }
+
+    // A request that no region can serve still fails cleanly.
+    REQUIRE(o1heapMultiAllocate(heap, SlowSize * 2U) == nullptr);
+    REQUIRE(o1heapMultiAllocateHinted(heap, SlowSize * 2U, O1HeapMultiHintSlow) == nullptr);
+}
@@ -0,0 +1,88 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+// This test is built with O1HEAP_DIAGNOSTICS=0, so the heavy validation machinery from internal.hpp cannot be
+// used here -- it cross-checks the diagnostic counters that are compiled out in this configuration.
+// Only the public API is exercised.
+
+#include "catch.hpp"
+#include "o1heap.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+constexpr std::size_t ArenaSize = 1024U * 64U;
+
+alignas(O1HEAP_ALIGNMENT) std::array<std::uint8_t, ArenaSize> g_arena{};
+
+}  // namespace
+
+TEST_CASE("NoDiag: general")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+
+    // Only the capacity is maintained in this configuration; the counters shall read as zero.
+    const O1HeapDiagnostics diag_init = o1heapGetDiagnostics(heap);
+    REQUIRE(diag_init.capacity > 0U);
+    REQUIRE(diag_init.capacity <= ArenaSize);
+    REQUIRE(diag_init.allocated == 0U);
+    REQUIRE(diag_init.peak_allocated == 0U);
+    REQUIRE(diag_init.peak_request_size == 0U);
+    REQUIRE(diag_init.oom_count == 0U);
+
+    // Exercise the allocation paths and ensure the memory is actually usable.
+    std::array<void*, 64U> pointers{};
+    for (std::size_t i = 0U; i < pointers.size(); i++)
+    {
+        pointers.at(i) = o1heapAllocate(heap, 100U + i);
+        REQUIRE(pointers.at(i) != nullptr);
+        REQUIRE((reinterpret_cast<std::uintptr_t>(pointers.at(i)) % O1HEAP_ALIGNMENT) == 0U);
+        std::memset(pointers.at(i), 0xA5, 100U + i);
+    }
+    REQUIRE(o1heapDoInvariantsHold(heap));
+
+    // Free every other fragment to exercise the merge logic, then reallocate across the gaps.
+    for (std::size_t i = 0U; i < pointers.size(); i += 2U)
+    {
+        o1heapFree(heap, pointers.at(i));
+        pointers.at(i) = nullptr;
+    }
+    for (std::size_t i = 1U; i < pointers.size(); i += 2U)
+    {
+        pointers.at(i) = o1heapReallocate(heap, pointers.at(i), 300U + i);
+        REQUIRE(pointers.at(i) != nullptr);
+    }
+    REQUIRE(o1heapDoInvariantsHold(heap));
+
+    // An impossible request shall fail but the OOM counter is compiled out so it shall remain zero.
+    REQUIRE(o1heapAllocate(heap, ArenaSize * 2U) == nullptr);
+    const O1HeapDiagnostics diag = o1heapGetDiagnostics(heap);
+    REQUIRE(diag.capacity == diag_init.capacity);
+    REQUIRE(diag.allocated == 0U);
+    REQUIRE(diag.peak_allocated == 0U);
+    REQUIRE(diag.peak_request_size == 0U);
+    REQUIRE(diag.oom_count == 0U);
+
+    for (auto* const ptr : pointers)
+    {
+        o1heapFree(heap, ptr);  // NULL pointers are no-ops.
+    }
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
@@ -0,0 +1,144 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+#include "o1heap.hpp"
+#include "catch.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t ArenaSize = 1024U * 64U;
+
+alignas(O1HEAP_ALIGNMENT) std::array<std::uint8_t, ArenaSize> g_arena{};
+
+bool inArena(const void* const pointer)
+{
+    return (pointer >= g_arena.data()) && (pointer < (g_arena.data() + g_arena.size()));
+}
+
+}  // namespace
+
+TEST_CASE("PMR: containers live in the arena")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+    o1heap::MemoryResource resource(heap);
+    REQUIRE(resource.instance() == heap);
+
+    {
+        std::pmr::vector<std::uint32_t> vec(&resource);
+        for (std::uint32_t i = 0U; i < 1000U; i++)
+        {
+            vec.push_back(i);
+        }
+        REQUIRE(inArena(vec.data()));
+        REQUIRE(vec.at(999U) == 999U);
+        REQUIRE(o1heapGetDiagnostics(heap).allocated > 0U);
+        REQUIRE(o1heapDoInvariantsHold(heap));
+
+        std::pmr::unordered_map<std::uint32_t, std::uint32_t> map(&resource);
+        for (std::uint32_t i = 0U; i < 100U; i++)
+        {
+            map.emplace(i, i * i);
+        }
+        REQUIRE(map.at(7U) == 49U);
+        REQUIRE(o1heapDoInvariantsHold(heap));
+    }
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == 0U);  // Everything returned on destruction.
+
+    // Two views of the same heap are interchangeable; a view of a different heap is not.
+    o1heap::MemoryResource same(heap);
+    REQUIRE(resource.is_equal(same));
+    alignas(O1HEAP_ALIGNMENT) std::array<std::uint8_t, 4096U> other_arena{};
+    o1heap::MemoryResource                                    other(o1heapInit(other_arena.data(), other_arena.size()));
+    REQUIRE(!resource.is_equal(other));
+}
+
+TEST_CASE("PMR: OOM throws bad_alloc")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+    o1heap::MemoryResource resource(heap);
+
+    REQUIRE_THROWS_AS(resource.allocate(ArenaSize * 2U), std::bad_alloc);
+    REQUIRE(o1heapGetDiagnostics(heap).oom_count == 1U);
+
+    // A zero-size request returns a valid unique pointer rather than nullptr.
+    void* const empty = resource.allocate(0U);
+    REQUIRE(empty != nullptr);
+    resource.deallocate(empty, 0U);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
+
+TEST_CASE("PMR: over-aligned allocation")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+    o1heap::MemoryResource resource(heap);
+
+    constexpr std::size_t Alignment = O1HEAP_ALIGNMENT * 8U;
+    void* const           pointer   = resource.allocate(64U, Alignment);
+    REQUIRE(pointer != nullptr);
+    REQUIRE((reinterpret_cast<std::uintptr_t>(pointer) % Alignment) == 0U);
+    REQUIRE(inArena(pointer));
+    resource.deallocate(pointer, 64U, Alignment);
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == 0U);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
+
+TEST_CASE("Allocator: classic containers")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    using Alloc = o1heap::Allocator<std::uint64_t>;
+    const Alloc alloc(heap);
+    REQUIRE(alloc.max_size() == (o1heapGetMaxAllocationSize(heap) / sizeof(std::uint64_t)));
+    REQUIRE(std::allocator_traits<Alloc>::max_size(alloc) == alloc.max_size());
+
+    {
+        std::vector<std::uint64_t, Alloc> vec(alloc);
+        for (std::uint64_t i = 0U; i < 1000U; i++)
+        {
+            vec.push_back(i * i);
+        }
+        REQUIRE(inArena(vec.data()));
+        REQUIRE(vec.at(30U) == 900U);
+        REQUIRE(o1heapDoInvariantsHold(heap));
+
+        // Rebound allocators view the same heap and compare equal across value types.
+        const o1heap::Allocator<char> rebound(alloc);
+        REQUIRE(rebound == alloc);
+        REQUIRE(!(rebound != alloc));
+    }
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == 0U);
+
+    // An impossible request is rejected without touching the heap; a merely excessive one counts as OOM.
+    Alloc mutable_alloc(heap);
+    REQUIRE_THROWS_AS(mutable_alloc.allocate(SIZE_MAX / sizeof(std::uint64_t)), std::bad_alloc);
+    REQUIRE(o1heapGetDiagnostics(heap).oom_count == 0U);
+    std::uint64_t* const big = mutable_alloc.allocate(alloc.max_size());  // The advertised maximum is honored.
+    REQUIRE(inArena(big));
+    REQUIRE_THROWS_AS(mutable_alloc.allocate(alloc.max_size()), std::bad_alloc);
+    REQUIRE(o1heapGetDiagnostics(heap).oom_count == 1U);
+    mutable_alloc.deallocate(big, alloc.max_size());
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == 0U);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
@@ -0,0 +1,306 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+// Trace-driven stress testing: a compact binary trace format (op, slot, size), a replayer that executes traces
+// against an instrumented instance verifying the full internal invariants after every operation, a fuzzer that
+// generates random traces, and a delta minimizer that shrinks a failing trace to a small reproducer.
+// Field-captured traces can be committed here as regression inputs; see the trace format description below.
+
+#include "internal.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <optional>
+
+namespace
+{
+constexpr std::size_t ArenaSize = 1024U * 64U;
+constexpr std::size_t NumSlots  = 64U;
+
+/// One trace record is 6 bytes on the wire, little-endian: op (1), slot (1), size (4).
+/// The slot index identifies one of NumSlots live-pointer registers, so traces are position-independent:
+/// - Allocate: allocate 'size' bytes into the slot, freeing its previous occupant first.
+/// - Free: free the pointer held in the slot; no-op if the slot is empty.
+/// - Reallocate: reallocate the slot to 'size' bytes; acts as Allocate if the slot is empty.
+enum class Op : std::uint8_t
+{
+    Allocate   = 0,
+    Free       = 1,
+    Reallocate = 2,
+};
+
+struct Record final
+{
+    Op            op{};
+    std::uint8_t  slot{};
+    std::uint32_t size{};
+};
+using Trace = std::vector<Record>;
+
+auto serialize(const Trace& trace) -> std::vector<std::uint8_t>
+{
+    std::vector<std::uint8_t> out;
+    out.reserve(trace.size() * 6U);
+    for (const auto& rec : trace)
+    {
+        out.push_back(static_cast<std::uint8_t>(rec.op));
+        out.push_back(rec.slot);
+        for (std::size_t i = 0U; i < 4U; i++)
+        {
+            out.push_back(static_cast<std::uint8_t>((rec.size >> (8U * i)) & 0xFFU));
+        }
+    }
+    return out;
+}
+
+auto deserialize(const std::vector<std::uint8_t>& bytes) -> std::optional<Trace>
+{
+    if ((bytes.size() % 6U) != 0U)
+    {
+        return {};
+    }
+    Trace out;
+    out.reserve(bytes.size() / 6U);
+    for (std::size_t i = 0U; i < bytes.size(); i += 6U)
+    {
+        if (bytes.at(i) > static_cast<std::uint8_t>(Op::Reallocate))
+        {
+            return {};
+        }
+        Record rec;
+        rec.op   = static_cast<Op>(bytes.at(i));
+        rec.slot = bytes.at(i + 1U);
+        rec.size = 0U;
+        for (std::size_t k = 0U; k < 4U; k++)
+        {
+            rec.size |= static_cast<std::uint32_t>(bytes.at(i + 2U + k)) << (8U * k);
+        }
+        out.push_back(rec);
+    }
+    return out;
+}
+
+/// Executes a trace from scratch against a fresh instrumented heap. Every operation goes through the internal.hpp
+/// wrappers, which validate the complete heap invariants (fragment chain, bins, free lists, diagnostics) before
+/// and after the call, so any corruption is reported at the exact offending record.
+class Replayer final
+{
+public:
+    Replayer()
+    {
+        std::generate(std::begin(arena_), std::end(arena_), [] { return static_cast<std::uint8_t>(std::rand()); });
+        heap_ = reinterpret_cast<internal::O1HeapInstance*>(o1heapInit(arena_.data(), std::size(arena_)));
+        REQUIRE(heap_ != nullptr);
+    }
+
+    void execute(const Record& rec)
+    {
+        void*& slot = slots_.at(rec.slot % NumSlots);
+        switch (rec.op)
+        {
+        case Op::Allocate:
+        {
+            heap_->free(slot);
+            slot = heap_->allocate(rec.size);
+            break;
+        }
+        case Op::Free:
+        {
+            heap_->free(slot);
+            slot = nullptr;
+            break;
+        }
+        case Op::Reallocate:
+        {
+            void* const out = heap_->reallocate(slot, rec.size);
+            slot            = (rec.size > 0U) ? ((out != nullptr) ? out : slot) : nullptr;
+            break;
+        }
+        default:
+        {
+            FAIL("Invalid trace record");
+        }
+        }
+    }
+
+    void execute(const Trace& trace)
+    {
+        for (const auto& rec : trace)
+        {
+            execute(rec);
+        }
+    }
+
+    /// Frees every live slot and checks that the heap drains back to zero. Call at the end of a replay.
+    void drain()
+    {
+        for (auto& slot : slots_)
+        {
+            heap_->free(slot);
+            slot = nullptr;
+        }
+        REQUIRE(heap_->getDiagnostics().allocated == 0U);
+        REQUIRE(heap_->doInvariantsHold());
+    }
+
+    [[nodiscard]] auto heap() -> internal::O1HeapInstance& { return *heap_; }
+
+private:
+    alignas(O1HEAP_ALIGNMENT) std::array<std::uint8_t, ArenaSize> arena_{};
+
+    internal::O1HeapInstance*     heap_ = nullptr;
+    std::array<void*, NumSlots>   slots_{};
+};
+
+/// Generates a pseudorandom trace; the same seed always yields the same trace so failures are reproducible.
+auto fuzz(const std::uint32_t seed, const std::size_t length) -> Trace
+{
+    std::uint32_t rng     = seed;
+    const auto    rand_u32 = [&rng] {
+        rng = (rng * 1664525U) + 1013904223U;
+        return rng >> 8U;
+    };
+    Trace out;
+    out.reserve(length);
+    for (std::size_t i = 0U; i < length; i++)
+    {
+        Record rec;
+        rec.op   = static_cast<Op>(rand_u32() % 3U);
+        rec.slot = static_cast<std::uint8_t>(rand_u32() % NumSlots);
+        // Mostly small requests with an occasional large one so that both splitting and OOM paths are exercised.
+        rec.size = ((rand_u32() % 16U) == 0U) ? (rand_u32() % ArenaSize) : (rand_u32() % 2048U);
+        out.push_back(rec);
+    }
+    return out;
+}
+
+/// Shrinks the trace to a (locally) minimal one that still satisfies the predicate, by repeatedly attempting to
+/// delete chunks of decreasing size (classic ddmin). The predicate shall be deterministic.
+auto minimize(Trace trace, const std::function<bool(const Trace&)>& predicate) -> Trace
+{
+    REQUIRE(predicate(trace));
+    for (std::size_t chunk = trace.size(); chunk >= 1U; chunk /= 2U)
+    {
+        bool progress = true;
+        while (progress && (trace.size() > 1U))
+        {
+            progress = false;
+            for (std::size_t pos = 0U; pos < trace.size(); pos += chunk)
+            {
+                Trace      candidate = trace;
+                const auto first     = candidate.begin() + static_cast<std::ptrdiff_t>(pos);
+                const auto last = candidate.begin() + static_cast<std::ptrdiff_t>(std::min(pos + chunk, trace.size()));
+                candidate.erase(first, last);
+                if ((!candidate.empty()) && predicate(candidate))
+                {
+                    trace    = candidate;
+                    progress = true;
+                    break;
+                }
+            }
+        }
+    }
+    return trace;
+}
+
+}  // namespace
+
+TEST_CASE("Replay: trace format round trip")
+{
+    const Trace trace{
+        {Op::Allocate, 0U, 512U},
+        {Op::Reallocate, 0U, 0xDEADBEEFU},
+        {Op::Free, 255U, 0U},
+    };
+    const auto bytes = serialize(trace);
+    REQUIRE(bytes.size() == (trace.size() * 6U));
+    const auto restored = deserialize(bytes);
+    REQUIRE(restored.has_value());
+    REQUIRE(restored->size() == trace.size());
+    for (std::size_t i = 0U; i < trace.size(); i++)
+    {
+        REQUIRE(restored->at(i).op == trace.at(i).op);
+        REQUIRE(restored->at(i).slot == trace.at(i).slot);
+        REQUIRE(restored->at(i).size == trace.at(i).size);
+    }
+    // Malformed inputs are rejected rather than misinterpreted.
+    REQUIRE(!deserialize(std::vector<std::uint8_t>(5U, 0U)).has_value());     // Truncated record.
+    REQUIRE(!deserialize(std::vector<std::uint8_t>{9U, 0U, 0U, 0U, 0U, 0U}).has_value());  // Unknown op.
+
+    // Traces survive a trip through a file, as they would when captured in the field.
+    std::FILE* const file = std::tmpfile();
+    REQUIRE(file != nullptr);
+    REQUIRE(std::fwrite(bytes.data(), 1U, bytes.size(), file) == bytes.size());
+    std::rewind(file);
+    std::vector<std::uint8_t> readback(bytes.size() + 1U);
+    const auto                read = std::fread(readback.data(), 1U, readback.size(), file);
+    REQUIRE(read == bytes.size());
+    readback.resize(read);
+    REQUIRE(std::fclose(file) == 0);
+    REQUIRE(deserialize(readback).has_value());
+}
+
+TEST_CASE("Replay: expand-backward interleaving regression")
+{
+    // The production failure mode: EXPAND-BACKWARD reallocations sliding objects into freshly freed neighbors,
+    // interleaved with frees. Each step is invariant-checked by the instrumented wrappers.
+    const Trace trace{
+        {Op::Allocate, 0U, 496U},    {Op::Allocate, 1U, 496U},    {Op::Allocate, 2U, 496U},
+        {Op::Allocate, 3U, 496U},    {Op::Free, 0U, 0U},          {Op::Reallocate, 1U, 900U},
+        {Op::Free, 2U, 0U},          {Op::Reallocate, 3U, 1400U}, {Op::Reallocate, 1U, 60U},
+        {Op::Reallocate, 3U, 2900U}, {Op::Free, 1U, 0U},          {Op::Reallocate, 3U, 16U},
+    };
+    Replayer replayer;
+    replayer.execute(trace);
+    replayer.drain();
+}
+
+TEST_CASE("Replay: fuzzing")
+{
+    for (std::uint32_t seed = 1U; seed <= 8U; seed++)
+    {
+        Replayer replayer;
+        replayer.execute(fuzz(seed, 2000U));
+        replayer.drain();
+    }
+}
+
+TEST_CASE("Replay: minimization")
+{
+    // The oracle replays the candidate trace from scratch and checks a property of the resulting heap state;
+    // here the "failure" being reduced is an observed OOM, standing in for a field-captured invariant violation.
+    const auto oom_observed = [](const Trace& candidate) {
+        Replayer replayer;
+        replayer.execute(candidate);
+        const bool hit = replayer.heap().getDiagnostics().oom_count > 0U;
+        replayer.drain();
+        return hit;
+    };
+
+    Trace trace = fuzz(0xACE1U, 250U);
+    if (!oom_observed(trace))  // Guarantee at least one OOM regardless of the constants above.
+    {
+        trace.push_back(Record{Op::Allocate, 0U, ArenaSize * 2U});
+    }
+    const Trace reduced = minimize(trace, oom_observed);
+    REQUIRE(!reduced.empty());
+    REQUIRE(reduced.size() <= trace.size());
+    REQUIRE(oom_observed(reduced));
+    // An OOM needs only the offending request, so the minimizer must get the reproducer down to a handful of
+    // records; a weaker result would indicate that it fails to delete independent chunks.
+    REQUIRE(reduced.size() <= 4U);
+}
@@ -0,0 +1,139 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+// This test is built with O1HEAP_ENABLE_RESERVE=1; it exercises the guaranteed-reserve pool through the public
+// interface only because the instance layout differs from the default mirrored in internal.hpp.
+
+#include "catch.hpp"
+#include "o1heap.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t ArenaSize     = 1024U * 64U;
+constexpr std::size_t ReserveAmount = 1000U;  // Rounds up to a 1 KiB fragment.
+constexpr std::size_t ReserveCount  = 3U;
+
+alignas(O1HEAP_ALIGNMENT) std::array<std::uint8_t, ArenaSize> g_arena{};
+
+/// Allocates until the heap reports OOM; returns the pointers so the caller can free them.
+auto exhaust(O1HeapInstance* const heap)
+{
+    std::vector<void*> out;
+    for (std::size_t amount = o1heapGetMaxAllocationSize(heap); amount > 0U; amount /= 2U)
+    {
+        for (void* ptr = o1heapAllocate(heap, amount); ptr != nullptr; ptr = o1heapAllocate(heap, amount))
+        {
+            out.push_back(ptr);
+        }
+    }
+    return out;
+}
+
+}  // namespace
+
+TEST_CASE("Reserve: allocation survives heap exhaustion")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+    REQUIRE(o1heapGetReservedCount(heap) == 0U);
+    REQUIRE(o1heapAllocateReserved(heap) == nullptr);  // Empty reserve; not an OOM event.
+    REQUIRE(o1heapGetDiagnostics(heap).oom_count == 0U);
+
+    REQUIRE(o1heapReserve(heap, ReserveAmount, ReserveCount) == ReserveCount);
+    REQUIRE(o1heapGetReservedCount(heap) == ReserveCount);
+    const std::size_t parked = o1heapGetDiagnostics(heap).allocated;
+    REQUIRE(parked >= ReserveCount * ReserveAmount);  // The reserve is accounted as allocated.
+
+    const auto hog = exhaust(heap);
+    REQUIRE(o1heapAllocate(heap, 1U) == nullptr);
+    REQUIRE(o1heapGetDiagnostics(heap).oom_count > 0U);
+
+    // The reserve delivers regardless of the bin state, and the memory is actually usable.
+    std::array<void*, ReserveCount> emergency{};
+    for (auto& p : emergency)
+    {
+        p = o1heapAllocateReserved(heap);
+        REQUIRE(p != nullptr);
+        REQUIRE(o1heapGetAllocatedSize(heap, p) >= ReserveAmount);
+        std::memset(p, 0xA5, ReserveAmount);
+    }
+    REQUIRE(o1heapGetReservedCount(heap) == 0U);
+    REQUIRE(o1heapAllocateReserved(heap) == nullptr);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+
+    // Freeing a reserve-obtained pointer replenishes the reserve rather than the general bins:
+    // the regular allocator still reports OOM but the next emergency allocation succeeds.
+    o1heapFree(heap, emergency.at(0U));
+    REQUIRE(o1heapGetReservedCount(heap) == 1U);
+    REQUIRE(o1heapAllocate(heap, ReserveAmount) == nullptr);
+    REQUIRE(o1heapAllocateReserved(heap) == emergency.at(0U));
+    REQUIRE(o1heapDoInvariantsHold(heap));
+
+    for (auto* const p : emergency)
+    {
+        o1heapFree(heap, p);
+    }
+    for (auto* const p : hog)
+    {
+        o1heapFree(heap, p);
+    }
+    REQUIRE(o1heapGetReservedCount(heap) == ReserveCount);
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == parked);  // Only the reserve remains parked.
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
+
+TEST_CASE("Reserve: partial carve on OOM")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    // Requesting more fragments than the arena can hold reserves as many as fit and reports the count.
+    const std::size_t reserved = o1heapReserve(heap, 4096U, 1000U);
+    REQUIRE(reserved > 0U);
+    REQUIRE(reserved < 1000U);
+    REQUIRE(o1heapGetReservedCount(heap) == reserved);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+
+    // Every reserved fragment is actually deliverable.
+    for (std::size_t i = 0U; i < reserved; i++)
+    {
+        REQUIRE(o1heapAllocateReserved(heap) != nullptr);
+    }
+    REQUIRE(o1heapAllocateReserved(heap) == nullptr);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
+
+TEST_CASE("Reserve: reallocation demotes to a regular allocation")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    REQUIRE(o1heapReserve(heap, ReserveAmount, 1U) == 1U);
+    void* const ptr = o1heapAllocateReserved(heap);
+    REQUIRE(ptr != nullptr);
+
+    // Shrinking the fragment changes its size, so it must not return to the reserve when freed.
+    void* const shrunk = o1heapReallocate(heap, ptr, 16U);
+    REQUIRE(shrunk == ptr);  // Shrink is always in place.
+    o1heapFree(heap, shrunk);
+    REQUIRE(o1heapGetReservedCount(heap) == 0U);
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == 0U);  // Went back into the general bins.
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
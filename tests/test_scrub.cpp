@@ -0,0 +1,127 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+// This test is built with O1HEAP_ENABLE_SCRUB=1; it exercises the incremental scrubber through the public
+// interface only because the instance layout differs from the default mirrored in internal.hpp.
+
+#include "catch.hpp"
+#include "o1heap.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+constexpr std::size_t ArenaSize = 1024U * 64U;
+
+alignas(O1HEAP_ALIGNMENT) std::array<std::uint8_t, ArenaSize> g_arena{};
+
+bool isZeroed(const void* const ptr, const std::size_t amount)
+{
+    const auto* const bytes = static_cast<const std::uint8_t*>(ptr);
+    for (std::size_t i = 0U; i < amount; i++)
+    {
+        if (bytes[i] != 0U)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST_CASE("Scrub: fallback miss then constant-time hit")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+    REQUIRE(o1heapScrubStep(heap, 1024U) == 0U);  // Nothing to do yet -- no misses recorded.
+
+    // The first zeroed allocation misses the (empty) pool and falls back to an explicit memset.
+    constexpr std::size_t Amount = 100U;
+    void* const           first  = o1heapAllocateZeroed(heap, Amount);
+    REQUIRE(first != nullptr);
+    REQUIRE(isZeroed(first, Amount));
+    const std::size_t frag_size = o1heapGetDiagnostics(heap).allocated;
+    std::memset(first, 0xAA, Amount);
+    o1heapFree(heap, first);
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == 0U);
+
+    // The miss was recorded; a single generous scrub step replenishes the whole size class.
+    REQUIRE(o1heapScrubStep(heap, ArenaSize) == (frag_size - O1HEAP_ALIGNMENT));
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == frag_size);  // Parked memory is reported as allocated.
+    REQUIRE(o1heapScrubStep(heap, ArenaSize) == 0U);             // No further demand.
+    REQUIRE(o1heapDoInvariantsHold(heap));
+
+    // The next zeroed allocation of the same class is served from the pool, fully zeroed.
+    void* const second = o1heapAllocateZeroed(heap, Amount);
+    REQUIRE(second != nullptr);
+    REQUIRE(isZeroed(second, frag_size - O1HEAP_ALIGNMENT));
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == frag_size);  // Pop does not change the accounting.
+    REQUIRE(o1heapDoInvariantsHold(heap));
+    o1heapFree(heap, second);
+}
+
+TEST_CASE("Scrub: bounded incremental steps")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    // Record a miss for a size class whose payload takes many small steps to zero.
+    constexpr std::size_t Amount = 4000U;
+    void* const           ptr    = o1heapAllocateZeroed(heap, Amount);
+    REQUIRE(ptr != nullptr);
+    const std::size_t payload_size = o1heapGetDiagnostics(heap).allocated - O1HEAP_ALIGNMENT;
+    o1heapFree(heap, ptr);
+
+    // Each step is bounded by max_bytes regardless of the fragment size; the total covers the payload exactly.
+    constexpr std::size_t StepLimit = 256U;
+    std::size_t           total     = 0U;
+    for (;;)
+    {
+        const std::size_t done = o1heapScrubStep(heap, StepLimit);
+        if (done == 0U)
+        {
+            break;
+        }
+        REQUIRE(done <= StepLimit);
+        total += done;
+    }
+    REQUIRE(total == payload_size);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+
+    void* const zeroed = o1heapAllocateZeroed(heap, Amount);
+    REQUIRE(zeroed != nullptr);
+    REQUIRE(isZeroed(zeroed, payload_size));
+    REQUIRE(o1heapDoInvariantsHold(heap));
+    o1heapFree(heap, zeroed);
+}
+
+TEST_CASE("Scrub: demand is dropped on OOM instead of spinning")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    // Exhaust the heap, then record a miss for a class that can no longer be allocated.
+    while (o1heapAllocate(heap, 1024U) != nullptr)
+    {
+    }
+    void* const ptr = o1heapAllocateZeroed(heap, 1024U);
+    REQUIRE(ptr == nullptr);
+    REQUIRE(o1heapScrubStep(heap, ArenaSize) == 0U);  // The replenishment attempt fails quietly.
+    REQUIRE(o1heapScrubStep(heap, ArenaSize) == 0U);  // The demand bit is not retried forever.
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
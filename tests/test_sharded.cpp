@@ -0,0 +1,97 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+#include "catch.hpp"
+#include "o1heap_sharded.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t ArenaSize = 1024U * 256U;
+constexpr std::size_t NumShards = 4U;
+
+alignas(O1HEAP_ALIGNMENT) std::array<std::uint8_t, ArenaSize> g_arena{};
+
+}  // namespace
+
+TEST_CASE("Sharded: init")
+{
+    REQUIRE(o1heapShardedMinArenaSize(0U) == 0U);
+    REQUIRE(o1heapShardedMinArenaSize(1'000'000U) == 0U);  // Over the compile-time shard count limit.
+    REQUIRE(o1heapShardedMinArenaSize(1U) > o1heapMinArenaSize);
+    REQUIRE(o1heapShardedMinArenaSize(NumShards) > (o1heapMinArenaSize * NumShards));
+
+    REQUIRE(o1heapInitSharded(nullptr, ArenaSize, NumShards) == nullptr);
+    REQUIRE(o1heapInitSharded(g_arena.data() + 1U, ArenaSize - 1U, NumShards) == nullptr);  // Misaligned.
+    REQUIRE(o1heapInitSharded(g_arena.data(), o1heapShardedMinArenaSize(NumShards) - 1U, NumShards) == nullptr);
+    REQUIRE(o1heapInitSharded(g_arena.data(), ArenaSize, 0U) == nullptr);
+
+    O1HeapShardedInstance* const heap = o1heapInitSharded(g_arena.data(), ArenaSize, NumShards);
+    REQUIRE(heap != nullptr);
+    REQUIRE(o1heapShardedGetNumShards(heap) == NumShards);
+    REQUIRE(o1heapShardedGetShard(heap, NumShards) == nullptr);
+    for (std::size_t i = 0U; i < NumShards; i++)
+    {
+        O1HeapInstance* const shard = o1heapShardedGetShard(heap, i);
+        REQUIRE(shard != nullptr);
+        REQUIRE(o1heapDoInvariantsHold(shard));
+        REQUIRE(o1heapGetDiagnostics(shard).allocated == 0U);
+    }
+}
+
+TEST_CASE("Sharded: overflow and routing")
+{
+    O1HeapShardedInstance* const heap = o1heapInitSharded(g_arena.data(), ArenaSize, NumShards);
+    REQUIRE(heap != nullptr);
+
+    // Exhaust shard 0 through the core API until it cannot serve 1 KiB requests anymore.
+    std::vector<void*> blocks;
+    while (void* const ptr = o1heapAllocate(o1heapShardedGetShard(heap, 0U), 1024U))
+    {
+        std::memset(ptr, 0x5A, 1024U);
+        blocks.push_back(ptr);
+        if (blocks.size() > (ArenaSize / 1024U))
+        {
+            FAIL("Unreachable: the shard should have been exhausted by now");
+        }
+    }
+
+    // Shard 0 is full, so the next allocation shall overflow into a neighbor instead of failing.
+    void* const overflow = o1heapShardedAllocate(heap, 0U, 1024U);
+    REQUIRE(overflow != nullptr);
+    bool found_in_neighbor = false;
+    for (std::size_t i = 1U; i < NumShards; i++)
+    {
+        found_in_neighbor = found_in_neighbor || (o1heapGetDiagnostics(o1heapShardedGetShard(heap, i)).allocated > 0U);
+    }
+    REQUIRE(found_in_neighbor);
+
+    // Frees are routed back to the owning shards purely by address.
+    o1heapShardedFree(heap, overflow);
+    for (auto* const ptr : blocks)
+    {
+        o1heapShardedFree(heap, ptr);
+    }
+    o1heapShardedFree(heap, nullptr);  // No-op.
+    for (std::size_t i = 0U; i < NumShards; i++)
+    {
+        REQUIRE(o1heapDoInvariantsHold(o1heapShardedGetShard(heap, i)));
+        REQUIRE(o1heapGetDiagnostics(o1heapShardedGetShard(heap, i)).allocated == 0U);
+    }
+}
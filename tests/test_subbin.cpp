@@ -0,0 +1,163 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+// This test is built with O1HEAP_SUBBIN_BITS=3 (TLSF-style two-level bins); it exercises the sub-bin sizing policy
+// through the public interface only because the instance layout differs from the default mirrored in internal.hpp.
+
+#include "catch.hpp"
+#include "o1heap.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t ArenaSize   = 1024U * 64U;
+constexpr std::size_t FragSizeMin = 2U * O1HEAP_ALIGNMENT;
+
+alignas(O1HEAP_ALIGNMENT) std::array<std::uint8_t, ArenaSize> g_arena{};
+
+/// The expected fragment size under the sub-bin policy: header plus payload, rounded up to the fragment granularity.
+std::size_t expectedFragmentSize(const std::size_t amount)
+{
+    return ((amount + O1HEAP_ALIGNMENT) + (FragSizeMin - 1U)) & ~(FragSizeMin - 1U);
+}
+
+}  // namespace
+
+TEST_CASE("Subbin: granular size accounting")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    // Sizes round up to the fragment granularity rather than to the next power of 2.
+    std::size_t expected_allocated = 0U;
+    for (const std::size_t amount : {1U, 100U, 257U, 1000U, 5000U, 10'000U})
+    {
+        void* const ptr = o1heapAllocate(heap, amount);
+        REQUIRE(ptr != nullptr);
+        std::memset(ptr, 0xA5, amount);
+        expected_allocated += expectedFragmentSize(amount);
+        REQUIRE(o1heapGetDiagnostics(heap).allocated == expected_allocated);
+    }
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
+
+TEST_CASE("Subbin: reduced internal fragmentation")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    // A 288-byte payload occupies a 512-byte fragment under the power-of-2 policy, so a 64K arena fits about 126.
+    // Under the sub-bin policy the fragment shrinks to at most 288+2*O1HEAP_ALIGNMENT bytes, fitting many more.
+    std::size_t count = 0U;
+    while (o1heapAllocate(heap, 288U) != nullptr)
+    {
+        count++;
+    }
+    REQUIRE(count >= 150U);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
+
+TEST_CASE("Subbin: max allocation size is allocatable")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    const std::size_t max_amount = o1heapGetMaxAllocationSize(heap);
+    REQUIRE(max_amount > 0U);
+    void* const ptr = o1heapAllocate(heap, max_amount);
+    REQUIRE(ptr != nullptr);
+    std::memset(ptr, 0x5A, max_amount);
+    o1heapFree(heap, ptr);
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == 0U);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
+
+TEST_CASE("Subbin: randomized stress")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    std::uint32_t rng      = 0xDEADBEEFU;
+    const auto    rand_u32 = [&rng]() {
+        rng = (rng * 1664525U) + 1013904223U;
+        return rng;
+    };
+    std::vector<std::pair<void*, std::size_t>> live;
+    for (std::size_t iteration = 0U; iteration < 20'000U; iteration++)
+    {
+        if (((rand_u32() % 2U) == 0U) || live.empty())
+        {
+            const std::size_t amount = 1U + (rand_u32() % 2000U);
+            void* const       ptr    = (rand_u32() % 4U == 0U) ? o1heapReallocate(heap, nullptr, amount)
+                                                               : o1heapAllocate(heap, amount);
+            if (ptr != nullptr)
+            {
+                std::memset(ptr, static_cast<int>(iteration & 0xFFU), amount);
+                live.emplace_back(ptr, amount);
+            }
+        }
+        else
+        {
+            const std::size_t idx = rand_u32() % live.size();
+            o1heapFree(heap, live.at(idx).first);
+            live.at(idx) = live.back();
+            live.pop_back();
+        }
+        if ((iteration % 1000U) == 0U)
+        {
+            REQUIRE(o1heapDoInvariantsHold(heap));
+        }
+    }
+    for (const auto& [ptr, amount] : live)
+    {
+        o1heapFree(heap, ptr);
+    }
+    REQUIRE(o1heapGetDiagnostics(heap).allocated == 0U);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
+
+TEST_CASE("Subbin: largest available is allocatable")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    // Fragment the heap with a checkerboard of odd-sized holes, then verify the guarantee: the reported amount
+    // shall be allocatable right now, including the sub-bin mapping-search rounding.
+    std::array<void*, 24U> blocks{};
+    for (auto& ptr : blocks)
+    {
+        ptr = o1heapAllocate(heap, 1000U);
+        REQUIRE(ptr != nullptr);
+    }
+    for (std::size_t i = 0U; i < blocks.size(); i += 2U)
+    {
+        o1heapFree(heap, blocks.at(i));
+        blocks.at(i) = nullptr;
+    }
+    while (o1heapGetLargestAvailable(heap) != 0U)
+    {
+        const std::size_t avail      = o1heapGetLargestAvailable(heap);
+        const auto        oom_before = o1heapGetDiagnostics(heap).oom_count;
+        void* const       ptr        = o1heapAllocate(heap, avail);
+        REQUIRE(ptr != nullptr);
+        REQUIRE(o1heapGetDiagnostics(heap).oom_count == oom_before);
+    }
+    REQUIRE(o1heapGetDiagnostics(heap).oom_count == 0U);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
@@ -0,0 +1,160 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+// This test is built with O1HEAP_TELEMETRY=1; it exercises the free-space telemetry through the public
+// interface only because the instance layout differs from the default mirrored in internal.hpp.
+
+#include "catch.hpp"
+#include "o1heap.h"
+#include <array>
+#include <cstdint>
+#include <numeric>
+
+namespace
+{
+constexpr std::size_t ArenaSize = 1024U * 64U;
+
+alignas(O1HEAP_ALIGNMENT) std::array<std::uint8_t, ArenaSize> g_arena{};
+
+std::size_t countFreeFragments(const O1HeapTelemetry& telemetry)
+{
+    return std::accumulate(std::begin(telemetry.bin_fragment_counts), std::end(telemetry.bin_fragment_counts), 0UL);
+}
+
+bool isMaskConsistent(const O1HeapTelemetry& telemetry)
+{
+    for (std::size_t i = 0U; i < O1HEAP_BIN_COUNT; i++)
+    {
+        const bool mask_bit_set = (telemetry.nonempty_bin_mask & (static_cast<std::size_t>(1U) << i)) != 0U;
+        if (mask_bit_set != (telemetry.bin_fragment_counts[i] > 0U))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST_CASE("Telemetry: counters track the heap state")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    // A freshly initialized heap contains a single free fragment and has seen no splits or merges.
+    const O1HeapTelemetry initial = o1heapGetTelemetry(heap);
+    REQUIRE(countFreeFragments(initial) == 1U);
+    REQUIRE(isMaskConsistent(initial));
+    REQUIRE(initial.split_count == 0U);
+    REQUIRE(initial.merge_count == 0U);
+
+    // The first allocation splits the root fragment.
+    void* const ptr = o1heapAllocate(heap, 64U);
+    REQUIRE(ptr != nullptr);
+    {
+        const O1HeapTelemetry telemetry = o1heapGetTelemetry(heap);
+        REQUIRE(countFreeFragments(telemetry) == 1U);  // The leftover.
+        REQUIRE(isMaskConsistent(telemetry));
+        REQUIRE(telemetry.split_count == 1U);
+        REQUIRE(telemetry.merge_count == 0U);
+    }
+
+    // Freeing it merges the fragment back with the leftover, restoring the initial free-space state.
+    o1heapFree(heap, ptr);
+    {
+        const O1HeapTelemetry telemetry = o1heapGetTelemetry(heap);
+        REQUIRE(countFreeFragments(telemetry) == 1U);
+        REQUIRE(telemetry.nonempty_bin_mask == initial.nonempty_bin_mask);
+        REQUIRE(telemetry.split_count == 1U);
+        REQUIRE(telemetry.merge_count == 1U);
+    }
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
+
+TEST_CASE("Telemetry: fragmentation is visible in the bin mask")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    // A checkerboard of allocations leaves many small free fragments that cannot coalesce.
+    std::array<void*, 16U> pointers{};
+    for (auto& p : pointers)
+    {
+        p = o1heapAllocate(heap, 1024U);
+        REQUIRE(p != nullptr);
+    }
+    for (std::size_t i = 0U; i < pointers.size(); i += 2U)
+    {
+        o1heapFree(heap, pointers.at(i));
+    }
+    const O1HeapTelemetry fragmented = o1heapGetTelemetry(heap);
+    REQUIRE(countFreeFragments(fragmented) >= (pointers.size() / 2U));
+    REQUIRE(isMaskConsistent(fragmented));
+
+    // The topmost set bit of the mask bounds the size of the largest servable request from above:
+    // a request that requires a higher bin than any available shall fail.
+    std::size_t top = 0U;
+    for (std::size_t i = 0U; i < O1HEAP_BIN_COUNT; i++)
+    {
+        if ((fragmented.nonempty_bin_mask & (static_cast<std::size_t>(1U) << i)) != 0U)
+        {
+            top = i;
+        }
+    }
+    const std::size_t largest_guaranteed = ((static_cast<std::size_t>(1U) << top) * (O1HEAP_ALIGNMENT * 2U));
+    REQUIRE(o1heapAllocate(heap, largest_guaranteed) == nullptr);  // Requires the next size class up.
+    void* const fit = o1heapAllocate(heap, largest_guaranteed - O1HEAP_ALIGNMENT);
+    REQUIRE(fit != nullptr);
+    o1heapFree(heap, fit);
+
+    // Merges are counted as the checkerboard collapses back into one fragment.
+    for (std::size_t i = 1U; i < pointers.size(); i += 2U)
+    {
+        o1heapFree(heap, pointers.at(i));
+    }
+    const O1HeapTelemetry merged = o1heapGetTelemetry(heap);
+    REQUIRE(countFreeFragments(merged) == 1U);
+    REQUIRE(isMaskConsistent(merged));
+    REQUIRE(merged.merge_count > fragmented.merge_count);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
+
+TEST_CASE("Telemetry: reallocation updates the split/merge counters")
+{
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+
+    void* const ptr = o1heapAllocate(heap, 1024U);
+    REQUIRE(ptr != nullptr);
+    const O1HeapTelemetry before = o1heapGetTelemetry(heap);
+
+    // Shrinking in place splits the fragment; the leftover merges with the free space that follows.
+    REQUIRE(o1heapReallocate(heap, ptr, 100U) == ptr);
+    const O1HeapTelemetry shrunk = o1heapGetTelemetry(heap);
+    REQUIRE(shrunk.split_count == (before.split_count + 1U));
+    REQUIRE(shrunk.merge_count == (before.merge_count + 1U));
+    REQUIRE(isMaskConsistent(shrunk));
+
+    // Growing back in place splits the following free fragment again, merging its front part in.
+    REQUIRE(o1heapReallocate(heap, ptr, 1024U) == ptr);
+    const O1HeapTelemetry grown = o1heapGetTelemetry(heap);
+    REQUIRE(grown.split_count == (shrunk.split_count + 1U));
+    REQUIRE(grown.merge_count == (shrunk.merge_count + 1U));
+    REQUIRE(isMaskConsistent(grown));
+
+    o1heapFree(heap, ptr);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}
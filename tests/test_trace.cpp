@@ -0,0 +1,156 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+// documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+// and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions
+// of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+// WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS
+// OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// Copyright (c) Pavel Kirienko
+// Authors: Pavel Kirienko <pavel.kirienko@zubax.com>
+
+// This test is built with the library's O1HEAP_TRACE_HOOK() wired to the reference ring-buffer recorder via
+// the config header cfg_test_trace.h; it verifies both the recorder itself and the hook invocation sites.
+
+#include "catch.hpp"
+#include "o1heap.h"
+#include "o1heap_trace.h"
+#include <array>
+#include <cstdint>
+
+extern "C" {
+O1HeapTraceRecorder g_test_trace_recorder{};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+}
+
+namespace
+{
+constexpr std::size_t ArenaSize = 1024U * 64U;
+
+alignas(O1HEAP_ALIGNMENT) std::array<std::uint8_t, ArenaSize> g_arena{};
+
+std::array<O1HeapTraceRecord, 256U> g_records{};
+
+std::uint64_t g_fake_time = 0U;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+std::uint64_t fakeTimestamp()
+{
+    return ++g_fake_time;
+}
+
+}  // namespace
+
+TEST_CASE("Trace: recorder ring buffer")
+{
+    std::array<O1HeapTraceRecord, 4U> small{};
+    O1HeapTraceRecorder               rec{};
+    o1heapTraceRecorderInit(&rec, small.data(), small.size(), nullptr);
+    REQUIRE(o1heapTraceGetCount(&rec) == 0U);
+    REQUIRE(o1heapTraceGetRecord(&rec, 0U) == nullptr);
+
+    for (std::size_t i = 0U; i < 6U; i++)
+    {
+        o1heapTraceRecord(&rec, O1HEAP_TRACE_EVENT_ALLOCATE, &small, i);
+    }
+    // The buffer has wrapped: the two oldest records are gone, the retained ones are ordered oldest-first.
+    REQUIRE(o1heapTraceGetCount(&rec) == 4U);
+    REQUIRE(rec.total == 6U);
+    for (std::size_t i = 0U; i < 4U; i++)
+    {
+        const O1HeapTraceRecord* const r = o1heapTraceGetRecord(&rec, i);
+        REQUIRE(r != nullptr);
+        REQUIRE(r->size == (i + 2U));
+        REQUIRE(r->timestamp == (i + 2U));  // No time source: the sequence number doubles as the timestamp.
+    }
+    REQUIRE(o1heapTraceGetRecord(&rec, 4U) == nullptr);
+}
+
+TEST_CASE("Trace: hook invocation sites")
+{
+    o1heapTraceRecorderInit(&g_test_trace_recorder, g_records.data(), g_records.size(), &fakeTimestamp);
+    O1HeapInstance* const heap = o1heapInit(g_arena.data(), g_arena.size());
+    REQUIRE(heap != nullptr);
+    const std::uint64_t baseline = g_test_trace_recorder.total;  // Init itself emits no events.
+    REQUIRE(baseline == 0U);
+
+    const auto last = [] {
+        const std::size_t count = o1heapTraceGetCount(&g_test_trace_recorder);
+        REQUIRE(count > 0U);
+        return o1heapTraceGetRecord(&g_test_trace_recorder, count - 1U);
+    };
+
+    // A successful allocation reports the resulting pointer and the requested amount.
+    void* const a = o1heapAllocate(heap, 100U);
+    REQUIRE(a != nullptr);
+    REQUIRE(last()->event == O1HEAP_TRACE_EVENT_ALLOCATE);
+    REQUIRE(last()->pointer == reinterpret_cast<std::uintptr_t>(a));
+    REQUIRE(last()->size == 100U);
+    REQUIRE(last()->timestamp > 0U);  // The user-provided time source is consulted.
+
+    // A failed allocation is reported too, with a zero pointer; an OOM is visible in the trace.
+    REQUIRE(o1heapAllocate(heap, ArenaSize * 2U) == nullptr);
+    REQUIRE(last()->event == O1HEAP_TRACE_EVENT_ALLOCATE);
+    REQUIRE(last()->pointer == 0U);
+    REQUIRE(last()->size == (ArenaSize * 2U));
+
+    // An in-place reallocation emits a single event carrying the old pointer and the new request.
+    const std::uint64_t before_realloc = g_test_trace_recorder.total;
+    REQUIRE(o1heapReallocate(heap, a, 50U) == a);  // Shrink never moves.
+    REQUIRE(g_test_trace_recorder.total == (before_realloc + 1U));
+    REQUIRE(last()->event == O1HEAP_TRACE_EVENT_REALLOCATE);
+    REQUIRE(last()->pointer == reinterpret_cast<std::uintptr_t>(a));
+    REQUIRE(last()->size == 50U);
+
+    // A free reports the pointer and the payload capacity of the returned fragment.
+    o1heapFree(heap, a);
+    REQUIRE(last()->event == O1HEAP_TRACE_EVENT_FREE);
+    REQUIRE(last()->pointer == reinterpret_cast<std::uintptr_t>(a));
+    REQUIRE(last()->size >= 50U);
+    o1heapFree(heap, nullptr);  // The no-op does not pollute the trace.
+    REQUIRE(last()->event == O1HEAP_TRACE_EVENT_FREE);
+
+    // The delegation edge cases of realloc are reported as the plain operations they delegate to.
+    void* const b = o1heapReallocate(heap, nullptr, 16U);
+    REQUIRE(b != nullptr);
+    REQUIRE(last()->event == O1HEAP_TRACE_EVENT_ALLOCATE);
+    REQUIRE(o1heapReallocate(heap, b, 0U) == nullptr);
+    REQUIRE(last()->event == O1HEAP_TRACE_EVENT_FREE);
+
+    // A moving reallocation emits its own event followed by the nested allocate/free pair.
+    void* const c = o1heapAllocate(heap, 64U);
+    void* const d = o1heapAllocate(heap, 64U);  // Blocks in-place expansion of c.
+    REQUIRE(c != nullptr);
+    REQUIRE(d != nullptr);
+    const std::uint64_t before_move = g_test_trace_recorder.total;
+    void* const         moved      = o1heapReallocate(heap, c, 4096U);
+    REQUIRE(moved != nullptr);
+    REQUIRE(moved != c);
+    REQUIRE(g_test_trace_recorder.total == (before_move + 3U));
+    const std::size_t count = o1heapTraceGetCount(&g_test_trace_recorder);
+    REQUIRE(o1heapTraceGetRecord(&g_test_trace_recorder, count - 3U)->event == O1HEAP_TRACE_EVENT_REALLOCATE);
+    REQUIRE(o1heapTraceGetRecord(&g_test_trace_recorder, count - 2U)->event == O1HEAP_TRACE_EVENT_ALLOCATE);
+    REQUIRE(o1heapTraceGetRecord(&g_test_trace_recorder, count - 1U)->event == O1HEAP_TRACE_EVENT_FREE);
+
+    // The batch API emits one event per element, so batch traffic remains replayable like regular traffic.
+    std::array<void*, 5U> batch{};
+    const std::uint64_t   before_batch = g_test_trace_recorder.total;
+    REQUIRE(o1heapAllocateBatch(heap, 48U, batch.size(), batch.data()) == batch.size());
+    REQUIRE(g_test_trace_recorder.total == (before_batch + batch.size()));
+    const std::size_t batch_count = o1heapTraceGetCount(&g_test_trace_recorder);
+    for (std::size_t i = 0U; i < batch.size(); i++)
+    {
+        const O1HeapTraceRecord* const rec =
+            o1heapTraceGetRecord(&g_test_trace_recorder, (batch_count - batch.size()) + i);
+        REQUIRE(rec->event == O1HEAP_TRACE_EVENT_ALLOCATE);
+        REQUIRE(rec->pointer == reinterpret_cast<std::uintptr_t>(batch.at(i)));
+        REQUIRE(rec->size == 48U);
+    }
+    o1heapFreeBatch(heap, batch.data(), batch.size());
+    REQUIRE(g_test_trace_recorder.total == (before_batch + (batch.size() * 2U)));
+    REQUIRE(last()->event == O1HEAP_TRACE_EVENT_FREE);
+    REQUIRE(o1heapDoInvariantsHold(heap));
+}